@@ -0,0 +1,107 @@
+// 18 october 2026
+#include <stdint.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// This is uiAreaSetAnimationCallback() for the OSs that don't give us a frame clock we can hook into from a uiArea.
+// All animating areas share one timer, which stops itself once there's nothing left to animate.
+// Keeping the animations in a list instead of giving each its own timer means stopping one can free it right away; there's no way to cancel a uiTimer() otherwise.
+
+// this is 60 frames per second, give or take; uiTimer() can't do any better than milliseconds anyway
+#define frameInterval 16
+
+struct animation {
+	uiArea *a;
+	uiAreaAnimationFunc f;
+	void *data;
+	int stopped;
+	struct animation *next;
+};
+
+static struct animation *animations = NULL;
+static int timerRunning = 0;
+// where a uiTimer() outlives uiUninit(), this keeps the old one from ticking alongside a new one after the next uiInit()
+static intptr_t timerGeneration = 0;
+// callbacks can start and stop animations, so while we're walking the list, stopped animations are only marked and freed afterward
+static int ticking = 0;
+
+static void sweep(void)
+{
+	struct animation **pp;
+	struct animation *an;
+
+	pp = &animations;
+	while (*pp != NULL) {
+		an = *pp;
+		if (!an->stopped) {
+			pp = &(an->next);
+			continue;
+		}
+		*pp = an->next;
+		uiprivFree(an);
+	}
+}
+
+static int tick(void *data)
+{
+	struct animation *an;
+	double frameTime;
+
+	if ((intptr_t) data != timerGeneration)
+		return 0;
+	frameTime = uiprivMonotonicTime();
+	ticking = 1;
+	// new animations go at the front of the list, so anything started from a callback waits for the next frame
+	for (an = animations; an != NULL; an = an->next) {
+		if (an->stopped)
+			continue;
+		if (!(*(an->f))(an->a, frameTime, frameTime + frameInterval / 1000.0, an->data))
+			an->stopped = 1;
+	}
+	ticking = 0;
+	sweep();
+	if (animations == NULL) {
+		timerRunning = 0;
+		return 0;
+	}
+	return 1;
+}
+
+void uiprivFallbackSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data)
+{
+	struct animation *an;
+
+	for (an = animations; an != NULL; an = an->next)
+		if (an->a == a)
+			an->stopped = 1;
+	if (!ticking)
+		sweep();
+	if (f == NULL)
+		return;
+	an = uiprivNew(struct animation);
+	an->a = a;
+	an->f = f;
+	an->data = data;
+	an->next = animations;
+	animations = an;
+	if (!timerRunning) {
+		timerRunning = 1;
+		uiTimer(frameInterval, tick, (void *) timerGeneration);
+	}
+}
+
+// any areas still animating at uiUninit() never got the chance to stop, so free what's left
+// the timer itself is freed by the OS-specific uiUninit() where it can be, and otherwise stops itself the next time it fires
+void uiprivUninitAreaAnimation(void)
+{
+	struct animation *an;
+
+	while (animations != NULL) {
+		an = animations;
+		animations = an->next;
+		uiprivFree(an);
+	}
+	timerRunning = 0;
+	ticking = 0;
+	timerGeneration++;
+}
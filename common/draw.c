@@ -0,0 +1,83 @@
+// 18 october 2026
+#include <math.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// This file provides basic utilities in case the platform doesn't provide any of its own for drawing tasks.
+// Like the ones in matrix.c, keep these minimal; they should only be built on top of the public API.
+
+// this makes dst a deep copy of src; free it with uiprivFreeBrushCopy()
+void uiprivCopyBrush(uiDrawBrush *dst, const uiDrawBrush *src)
+{
+	*dst = *src;
+	dst->Stops = NULL;
+	if (src->NumStops != 0) {
+		dst->Stops = (uiDrawBrushGradientStop *) uiprivAlloc(src->NumStops * sizeof (uiDrawBrushGradientStop), "uiDrawBrushGradientStop[]");
+		memcpy(dst->Stops, src->Stops, src->NumStops * sizeof (uiDrawBrushGradientStop));
+	}
+}
+
+void uiprivFreeBrushCopy(uiDrawBrush *b)
+{
+	if (b->Stops != NULL)
+		uiprivFree(b->Stops);
+	b->Stops = NULL;
+}
+
+// how far past the path a stroke can reach
+double uiprivStrokeOutset(const uiDrawStrokeParams *p)
+{
+	double outset;
+
+	outset = p->Thickness / 2;
+	// miter joins stick out by at most half the miter limit times the thickness
+	if (p->Join == uiDrawLineJoinMiter && p->MiterLimit > 1)
+		outset *= p->MiterLimit;
+	// square caps stick out diagonally past the end of the line
+	if (p->Cap == uiDrawLineCapSquare)
+		outset *= sqrt(2);
+	return outset;
+}
+
+static void fillRectsPath(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b)
+{
+	uiDrawPath *path;
+	size_t i;
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	for (i = 0; i < n; i++, rects += 4)
+		uiDrawPathAddRectangle(path, rects[0], rects[1], rects[2], rects[3]);
+	uiDrawPathEnd(path);
+	uiDrawFill(c, path, b);
+	uiDrawFreePath(path);
+}
+
+void uiprivFallbackFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b)
+{
+	if (n == 0)
+		return;
+	fillRectsPath(c, rects, n, b);
+}
+
+static int sameColor(const double *a, const double *b)
+{
+	return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+void uiprivFallbackFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n)
+{
+	uiDrawBrush b;
+	size_t i, j;
+
+	memset(&b, 0, sizeof (uiDrawBrush));
+	b.Type = uiDrawBrushTypeSolid;
+	for (i = 0; i < n; i = j) {
+		for (j = i; j < n && sameColor(colors + 4 * i, colors + 4 * j); j++)
+			;
+		b.R = colors[4 * i];
+		b.G = colors[4 * i + 1];
+		b.B = colors[4 * i + 2];
+		b.A = colors[4 * i + 3];
+		fillRectsPath(c, rects + 4 * i, j - i, &b);
+	}
+}
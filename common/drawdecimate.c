@@ -0,0 +1,124 @@
+// 18 october 2026
+#include <math.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// This is M4 decimation: the points are split into columns pixelTolerance wide, and only the first, last, smallest, and largest point of each column are kept, in their original order.
+// A line through those four points lights up exactly the same pixels as the line through all the points in the column did, so a series of any length turns into at most four points per column.
+// See Jugel et al., "M4: A Visualization-Oriented Time Series Data Aggregation" (VLDB 2014).
+
+struct point {
+	size_t i;
+	double x;
+	double y;
+};
+
+struct column {
+	int valid;
+	double col;
+	struct point first;
+	struct point min;
+	struct point max;
+	struct point last;
+};
+
+struct decimator {
+	uiDrawPath *path;
+	double *xy;
+	size_t len;
+	size_t cap;
+	struct column c;
+};
+
+static void appendPoint(struct decimator *d, const struct point *p)
+{
+	if (d->len == d->cap) {
+		d->cap *= 2;
+		if (d->cap == 0)
+			d->cap = 1024;
+		d->xy = (double *) uiprivRealloc(d->xy, 2 * d->cap * sizeof (double), "double[]");
+	}
+	d->xy[2 * d->len] = p->x;
+	d->xy[2 * d->len + 1] = p->y;
+	d->len++;
+}
+
+static void flushColumn(struct decimator *d)
+{
+	const struct point *a, *b;
+
+	if (!d->c.valid)
+		return;
+	d->c.valid = 0;
+	appendPoint(d, &(d->c.first));
+	// the extremes go in the order they appeared in
+	a = &(d->c.min);
+	b = &(d->c.max);
+	if (b->i < a->i) {
+		a = &(d->c.max);
+		b = &(d->c.min);
+	}
+	// and points that are more than one of first, min, max, and last only go in once
+	if (a->i != d->c.first.i)
+		appendPoint(d, a);
+	if (b->i != a->i && b->i != d->c.first.i)
+		appendPoint(d, b);
+	if (d->c.last.i != b->i && d->c.last.i != a->i && d->c.last.i != d->c.first.i)
+		appendPoint(d, &(d->c.last));
+}
+
+static void flushFigure(struct decimator *d)
+{
+	flushColumn(d);
+	if (d->len != 0)
+		uiDrawPathAddPolyline(d->path, d->xy, d->len);
+	d->len = 0;
+}
+
+void uiDrawPathAddDecimatedSeries(uiDrawPath *path, const double *xs, const double *ys, size_t n, uiDrawMatrix *m, double pixelTolerance)
+{
+	struct decimator d;
+	struct point p;
+	double col;
+	size_t i;
+
+	if (uiDrawPathEnded(path))
+		uiprivUserBug("You cannot call uiDrawPathAddDecimatedSeries() on a uiDrawPath that has already been ended. (path: %p)", path);
+	if (!(pixelTolerance > 0))
+		uiprivUserBug("You cannot call uiDrawPathAddDecimatedSeries() with a pixel tolerance of %g; it must be positive.", pixelTolerance);
+	memset(&d, 0, sizeof (struct decimator));
+	d.path = path;
+	for (i = 0; i < n; i++) {
+		// a NaN or infinite sample is a gap in the data, so end the figure there and start a new one at the next real sample
+		if (!isfinite(xs[i]) || !isfinite(ys[i])) {
+			flushFigure(&d);
+			continue;
+		}
+		p.i = i;
+		p.x = xs[i];
+		p.y = ys[i];
+		// this is what uiDrawMatrixTransformPoint() does, minus the function call per sample
+		if (m != NULL) {
+			p.x = m->M11 * xs[i] + m->M21 * ys[i] + m->M31;
+			p.y = m->M12 * xs[i] + m->M22 * ys[i] + m->M32;
+		}
+		col = floor(p.x / pixelTolerance);
+		// the samples don't have to be sorted; going back into an earlier column just starts a new one
+		if (d.c.valid && d.c.col != col)
+			flushColumn(&d);
+		if (!d.c.valid) {
+			d.c.valid = 1;
+			d.c.col = col;
+			d.c.first = p;
+			d.c.min = p;
+			d.c.max = p;
+		} else if (p.y < d.c.min.y)
+			d.c.min = p;
+		else if (p.y > d.c.max.y)
+			d.c.max = p;
+		d.c.last = p;
+	}
+	flushFigure(&d);
+	if (d.xy != NULL)
+		uiprivFree(d.xy);
+}
@@ -0,0 +1,320 @@
+// 18 october 2026
+#include <math.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// A uiDrawList is an array of operations, each of which knows the rectangle it can touch in the coordinates of the uiDrawContext it's drawn into.
+// Transforms, clips, saves, and restores are always replayed; drawing operations are skipped if their bounds miss the clip rectangle.
+// This is all built on top of the public API, so there's nothing OS-specific here except for getting the bounds of a path.
+
+enum {
+	opStroke,
+	opFill,
+	opText,
+	opTransform,
+	opClip,
+	opSave,
+	opRestore,
+};
+
+struct bounds {
+	double x0;
+	double y0;
+	double x1;
+	double y1;
+};
+
+struct op {
+	int type;
+	uiDrawPath *path;
+	uiDrawCachedBrush *brush;
+	uiDrawStrokeParams sp;
+	uiDrawTextLayout *tl;
+	double x;
+	double y;
+	uiDrawMatrix m;
+	// only for stroke, fill, and text
+	struct bounds b;
+	int visible;
+};
+
+// this is what uiDrawListSave() saves and uiDrawListRestore() restores while recording
+struct recordState {
+	uiDrawMatrix m;
+	struct bounds clip;
+	int clipped;
+};
+
+struct uiDrawList {
+	struct op *ops;
+	size_t len;
+	size_t cap;
+	struct recordState cur;
+	struct recordState *saved;
+	size_t nSaved;
+	size_t capSaved;
+};
+
+uiDrawList *uiDrawNewList(void)
+{
+	uiDrawList *l;
+
+	l = uiprivNew(uiDrawList);
+	uiDrawMatrixSetIdentity(&(l->cur.m));
+	return l;
+}
+
+void uiDrawFreeList(uiDrawList *l)
+{
+	size_t i;
+
+	for (i = 0; i < l->len; i++) {
+		if (l->ops[i].brush != NULL)
+			uiDrawFreeBrush(l->ops[i].brush);
+		if (l->ops[i].sp.Dashes != NULL)
+			uiprivFree(l->ops[i].sp.Dashes);
+	}
+	if (l->ops != NULL)
+		uiprivFree(l->ops);
+	if (l->saved != NULL)
+		uiprivFree(l->saved);
+	uiprivFree(l);
+}
+
+static struct op *newOp(uiDrawList *l, int type)
+{
+	struct op *o;
+
+	if (l->len == l->cap) {
+		l->cap *= 2;
+		if (l->cap == 0)
+			l->cap = 32;
+		l->ops = (struct op *) uiprivRealloc(l->ops, l->cap * sizeof (struct op), "struct op[]");
+	}
+	o = &(l->ops[l->len]);
+	l->len++;
+	memset(o, 0, sizeof (struct op));
+	o->type = type;
+	return o;
+}
+
+// this computes the bounds of the rectangle (x, y, width, height) after going through the current transform
+static void transformBounds(uiDrawList *l, double x, double y, double width, double height, struct bounds *b)
+{
+	double xs[4], ys[4];
+	int i;
+
+	xs[0] = x;
+	ys[0] = y;
+	xs[1] = x + width;
+	ys[1] = y;
+	xs[2] = x;
+	ys[2] = y + height;
+	xs[3] = x + width;
+	ys[3] = y + height;
+	for (i = 0; i < 4; i++)
+		uiDrawMatrixTransformPoint(&(l->cur.m), &(xs[i]), &(ys[i]));
+	b->x0 = xs[0];
+	b->y0 = ys[0];
+	b->x1 = xs[0];
+	b->y1 = ys[0];
+	for (i = 1; i < 4; i++) {
+		b->x0 = fmin(b->x0, xs[i]);
+		b->y0 = fmin(b->y0, ys[i]);
+		b->x1 = fmax(b->x1, xs[i]);
+		b->y1 = fmax(b->y1, ys[i]);
+	}
+}
+
+static int intersect(struct bounds *a, const struct bounds *b)
+{
+	a->x0 = fmax(a->x0, b->x0);
+	a->y0 = fmax(a->y0, b->y0);
+	a->x1 = fmin(a->x1, b->x1);
+	a->y1 = fmin(a->y1, b->y1);
+	return a->x0 < a->x1 && a->y0 < a->y1;
+}
+
+// this takes the bounds in user space, so any outset is transformed along with the shape
+static void setOpBounds(uiDrawList *l, struct op *o, double x, double y, double width, double height)
+{
+	transformBounds(l, x, y, width, height, &(o->b));
+	o->visible = 1;
+	if (l->cur.clipped)
+		o->visible = intersect(&(o->b), &(l->cur.clip));
+}
+
+static void checkPath(uiDrawPath *path, const char *func)
+{
+	if (!uiDrawPathEnded(path))
+		uiprivUserBug("You cannot pass a uiDrawPath that has not been ended to %s(). (path: %p)", func, path);
+}
+
+void uiDrawListStroke(uiDrawList *l, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p)
+{
+	struct op *o;
+	double x, y, width, height;
+	double outset;
+
+	checkPath(path, "uiDrawListStroke");
+	o = newOp(l, opStroke);
+	o->path = path;
+	o->brush = uiDrawNewBrush(b);
+	o->sp = *p;
+	o->sp.Dashes = NULL;
+	if (p->NumDashes != 0) {
+		o->sp.Dashes = (double *) uiprivAlloc(p->NumDashes * sizeof (double), "double[]");
+		memcpy(o->sp.Dashes, p->Dashes, p->NumDashes * sizeof (double));
+	}
+	if (!uiDrawPathBounds(path, &x, &y, &width, &height))
+		return;
+	outset = uiprivStrokeOutset(p);
+	setOpBounds(l, o, x - outset, y - outset, width + 2 * outset, height + 2 * outset);
+}
+
+void uiDrawListFill(uiDrawList *l, uiDrawPath *path, uiDrawBrush *b)
+{
+	struct op *o;
+	double x, y, width, height;
+
+	checkPath(path, "uiDrawListFill");
+	o = newOp(l, opFill);
+	o->path = path;
+	o->brush = uiDrawNewBrush(b);
+	if (!uiDrawPathBounds(path, &x, &y, &width, &height))
+		return;
+	// antialiasing can touch the pixels just outside the path
+	setOpBounds(l, o, x - 1, y - 1, width + 2, height + 2);
+}
+
+void uiDrawListText(uiDrawList *l, uiDrawTextLayout *tl, double x, double y)
+{
+	struct op *o;
+	double width, height;
+	double outset;
+
+	o = newOp(l, opText);
+	o->tl = tl;
+	o->x = x;
+	o->y = y;
+	uiDrawTextLayoutExtents(tl, &width, &height);
+	// glyphs can draw outside the logical extents of the layout, for instance with italics or diacritics, so leave some room
+	outset = height / 4;
+	setOpBounds(l, o, x - outset, y - outset, width + 2 * outset, height + 2 * outset);
+}
+
+void uiDrawListTransform(uiDrawList *l, uiDrawMatrix *m)
+{
+	struct op *o;
+	uiDrawMatrix n;
+
+	o = newOp(l, opTransform);
+	o->m = *m;
+	// m applies before everything that's already in the transform
+	n = *m;
+	uiDrawMatrixMultiply(&n, &(l->cur.m));
+	l->cur.m = n;
+}
+
+void uiDrawListClip(uiDrawList *l, uiDrawPath *path)
+{
+	struct op *o;
+	struct bounds b;
+	double x, y, width, height;
+
+	checkPath(path, "uiDrawListClip");
+	o = newOp(l, opClip);
+	o->path = path;
+	b.x0 = 0;
+	b.y0 = 0;
+	b.x1 = 0;
+	b.y1 = 0;
+	if (uiDrawPathBounds(path, &x, &y, &width, &height))
+		transformBounds(l, x, y, width, height, &b);
+	if (l->cur.clipped)
+		intersect(&b, &(l->cur.clip));
+	l->cur.clip = b;
+	l->cur.clipped = 1;
+}
+
+void uiDrawListSave(uiDrawList *l)
+{
+	newOp(l, opSave);
+	if (l->nSaved == l->capSaved) {
+		l->capSaved *= 2;
+		if (l->capSaved == 0)
+			l->capSaved = 8;
+		l->saved = (struct recordState *) uiprivRealloc(l->saved, l->capSaved * sizeof (struct recordState), "struct recordState[]");
+	}
+	l->saved[l->nSaved] = l->cur;
+	l->nSaved++;
+}
+
+void uiDrawListRestore(uiDrawList *l)
+{
+	if (l->nSaved == 0)
+		uiprivUserBug("You cannot call uiDrawListRestore() without a matching uiDrawListSave(). (list: %p)", l);
+	newOp(l, opRestore);
+	l->nSaved--;
+	l->cur = l->saved[l->nSaved];
+}
+
+void uiDrawListDraw(uiDrawContext *c, uiDrawList *l, double clipX, double clipY, double clipWidth, double clipHeight)
+{
+	struct bounds clip;
+	struct op *o;
+	size_t i;
+	size_t nSaves;
+
+	clip.x0 = clipX;
+	clip.y0 = clipY;
+	clip.x1 = clipX + clipWidth;
+	clip.y1 = clipY + clipHeight;
+	// the list's transforms and clips must not leak out, so wrap the whole thing in a save/restore pair
+	uiDrawSave(c);
+	nSaves = 0;
+	for (i = 0; i < l->len; i++) {
+		o = &(l->ops[i]);
+		switch (o->type) {
+		case opStroke:
+		case opFill:
+		case opText:
+			if (!o->visible)
+				continue;
+			if (o->b.x1 <= clip.x0 || o->b.x0 >= clip.x1)
+				continue;
+			if (o->b.y1 <= clip.y0 || o->b.y0 >= clip.y1)
+				continue;
+			break;
+		}
+		switch (o->type) {
+		case opStroke:
+			uiDrawStrokeCachedBrush(c, o->path, o->brush, &(o->sp));
+			break;
+		case opFill:
+			uiDrawFillCachedBrush(c, o->path, o->brush);
+			break;
+		case opText:
+			uiDrawText(c, o->tl, o->x, o->y);
+			break;
+		case opTransform:
+			uiDrawTransform(c, &(o->m));
+			break;
+		case opClip:
+			uiDrawClip(c, o->path);
+			break;
+		case opSave:
+			uiDrawSave(c);
+			nSaves++;
+			break;
+		case opRestore:
+			uiDrawRestore(c);
+			nSaves--;
+			break;
+		}
+	}
+	// and if the list was recorded with unbalanced saves, clean up after it
+	for (; nSaves != 0; nSaves--)
+		uiDrawRestore(c);
+	uiDrawRestore(c);
+}
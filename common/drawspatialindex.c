@@ -0,0 +1,273 @@
+// 18 october 2026
+#include <math.h>
+#include <stdlib.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// A uiDrawSpatialIndex is a packed R-tree: the rectangles are sorted so that neighbors in the array are neighbors on the screen (the sort-tile-recursive method), then grouped nodeSize at a time into nodes, which are grouped the same way until only one is left.
+// The whole tree lives in a single array of rectangles, one level after another, so there are no pointers to chase; a node's children are found from its index alone.
+// Packing the tree this way is much simpler than keeping an R-tree balanced one insertion at a time, and the result is faster to query; the price is that changes need a rebuild, which is why we wait until the next query to do it.
+
+#define nodeSize 16
+
+struct rect {
+	double x0;
+	double y0;
+	double x1;
+	double y1;
+};
+
+struct item {
+	struct rect r;
+	void *data;
+};
+
+struct uiDrawSpatialIndex {
+	struct item *items;
+	size_t len;
+	size_t cap;
+	// the tree; the first len entries are the items' rectangles in the same order as items
+	struct rect *nodes;
+	size_t nNodes;
+	// levels[i] is the index in nodes of the first node of level i; levels[nLevels] is nNodes
+	size_t *levels;
+	size_t nLevels;
+	int dirty;
+	int querying;
+};
+
+uiDrawSpatialIndex *uiDrawNewSpatialIndex(void)
+{
+	return uiprivNew(uiDrawSpatialIndex);
+}
+
+static void freeTree(uiDrawSpatialIndex *si)
+{
+	if (si->nodes != NULL)
+		uiprivFree(si->nodes);
+	if (si->levels != NULL)
+		uiprivFree(si->levels);
+	si->nodes = NULL;
+	si->nNodes = 0;
+	si->levels = NULL;
+	si->nLevels = 0;
+}
+
+void uiDrawFreeSpatialIndex(uiDrawSpatialIndex *si)
+{
+	freeTree(si);
+	if (si->items != NULL)
+		uiprivFree(si->items);
+	uiprivFree(si);
+}
+
+static void checkNotQuerying(uiDrawSpatialIndex *si, const char *func)
+{
+	if (si->querying)
+		uiprivUserBug("You cannot call %s() during uiDrawSpatialIndexQuery(). (index: %p)", func, si);
+}
+
+void uiDrawSpatialIndexAdd(uiDrawSpatialIndex *si, double x, double y, double width, double height, void *data)
+{
+	struct item *it;
+
+	checkNotQuerying(si, "uiDrawSpatialIndexAdd");
+	if (si->len == si->cap) {
+		si->cap *= 2;
+		if (si->cap == 0)
+			si->cap = 64;
+		si->items = (struct item *) uiprivRealloc(si->items, si->cap * sizeof (struct item), "struct item[]");
+	}
+	it = &(si->items[si->len]);
+	si->len++;
+	// allow negative widths and heights the same way paths do
+	it->r.x0 = fmin(x, x + width);
+	it->r.y0 = fmin(y, y + height);
+	it->r.x1 = fmax(x, x + width);
+	it->r.y1 = fmax(y, y + height);
+	it->data = data;
+	si->dirty = 1;
+}
+
+void uiDrawSpatialIndexRemove(uiDrawSpatialIndex *si, void *data)
+{
+	size_t i;
+
+	checkNotQuerying(si, "uiDrawSpatialIndexRemove");
+	// order doesn't matter until the next rebuild, so fill each hole with the last item
+	i = 0;
+	while (i < si->len) {
+		if (si->items[i].data != data) {
+			i++;
+			continue;
+		}
+		si->len--;
+		si->items[i] = si->items[si->len];
+		si->dirty = 1;
+	}
+}
+
+size_t uiDrawSpatialIndexCount(uiDrawSpatialIndex *si)
+{
+	return si->len;
+}
+
+static int compareX(const void *a, const void *b)
+{
+	const struct item *ia = (const struct item *) a;
+	const struct item *ib = (const struct item *) b;
+	double ca, cb;
+
+	ca = ia->r.x0 + ia->r.x1;
+	cb = ib->r.x0 + ib->r.x1;
+	if (ca < cb)
+		return -1;
+	if (ca > cb)
+		return 1;
+	return 0;
+}
+
+static int compareY(const void *a, const void *b)
+{
+	const struct item *ia = (const struct item *) a;
+	const struct item *ib = (const struct item *) b;
+	double ca, cb;
+
+	ca = ia->r.y0 + ia->r.y1;
+	cb = ib->r.y0 + ib->r.y1;
+	if (ca < cb)
+		return -1;
+	if (ca > cb)
+		return 1;
+	return 0;
+}
+
+static size_t divideRoundingUp(size_t a, size_t b)
+{
+	return (a + b - 1) / b;
+}
+
+// sort-tile-recursive: cut the items into vertical slices by x, then sort each slice by y, so each run of nodeSize items covers a small, roughly square area
+static void sortItems(uiDrawSpatialIndex *si)
+{
+	size_t leaves, slices, sliceLen;
+	size_t i, n;
+
+	qsort(si->items, si->len, sizeof (struct item), compareX);
+	leaves = divideRoundingUp(si->len, nodeSize);
+	slices = (size_t) ceil(sqrt((double) leaves));
+	sliceLen = slices * nodeSize;
+	for (i = 0; i < si->len; i += sliceLen) {
+		n = sliceLen;
+		if (n > si->len - i)
+			n = si->len - i;
+		qsort(si->items + i, n, sizeof (struct item), compareY);
+	}
+}
+
+static void rebuild(uiDrawSpatialIndex *si)
+{
+	size_t count, total, nLevels;
+	size_t level, i, j, end;
+	size_t child, parent;
+	struct rect *r;
+
+	freeTree(si);
+	si->dirty = 0;
+	if (si->len == 0)
+		return;
+	sortItems(si);
+
+	// count the nodes on every level first so everything can be allocated at once
+	count = si->len;
+	total = count;
+	nLevels = 1;
+	while (count > 1) {
+		count = divideRoundingUp(count, nodeSize);
+		total += count;
+		nLevels++;
+	}
+	si->nodes = (struct rect *) uiprivAlloc(total * sizeof (struct rect), "struct rect[]");
+	si->nNodes = total;
+	si->levels = (size_t *) uiprivAlloc((nLevels + 1) * sizeof (size_t), "size_t[]");
+	si->nLevels = nLevels;
+
+	for (i = 0; i < si->len; i++)
+		si->nodes[i] = si->items[i].r;
+	si->levels[0] = 0;
+	si->levels[1] = si->len;
+	for (level = 1; level < nLevels; level++) {
+		parent = si->levels[level];
+		for (child = si->levels[level - 1]; child < si->levels[level]; child = end) {
+			end = child + nodeSize;
+			if (end > si->levels[level])
+				end = si->levels[level];
+			r = &(si->nodes[parent]);
+			*r = si->nodes[child];
+			for (j = child + 1; j < end; j++) {
+				r->x0 = fmin(r->x0, si->nodes[j].x0);
+				r->y0 = fmin(r->y0, si->nodes[j].y0);
+				r->x1 = fmax(r->x1, si->nodes[j].x1);
+				r->y1 = fmax(r->y1, si->nodes[j].y1);
+			}
+			parent++;
+		}
+		si->levels[level + 1] = parent;
+	}
+}
+
+static int overlaps(const struct rect *a, const struct rect *b)
+{
+	return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+// the tree is at most log16(n) levels deep, and each level adds at most nodeSize entries, so a fixed-size stack is plenty
+#define maxStack (nodeSize * 16)
+
+void uiDrawSpatialIndexQuery(uiDrawSpatialIndex *si, double x, double y, double width, double height, uiDrawSpatialIndexQueryFunc f, void *senderData)
+{
+	struct rect q;
+	size_t stack[maxStack];
+	size_t levelStack[maxStack];
+	size_t sp;
+	size_t node, level;
+	size_t child, end;
+	int stop;
+
+	if (si->dirty)
+		rebuild(si);
+	if (si->nNodes == 0)
+		return;
+	q.x0 = fmin(x, x + width);
+	q.y0 = fmin(y, y + height);
+	q.x1 = fmax(x, x + width);
+	q.y1 = fmax(y, y + height);
+
+	si->querying = 1;
+	stop = 0;
+	sp = 0;
+	stack[sp] = si->nNodes - 1;
+	levelStack[sp] = si->nLevels - 1;
+	sp++;
+	while (sp != 0 && !stop) {
+		sp--;
+		node = stack[sp];
+		level = levelStack[sp];
+		if (!overlaps(&(si->nodes[node]), &q))
+			continue;
+		if (level == 0) {
+			stop = (*f)(si, si->items[node].data, senderData) == uiForEachStop;
+			continue;
+		}
+		child = si->levels[level - 1] + (node - si->levels[level]) * nodeSize;
+		end = child + nodeSize;
+		if (end > si->levels[level])
+			end = si->levels[level];
+		for (; child < end; child++) {
+			stack[sp] = child;
+			levelStack[sp] = level - 1;
+			sp++;
+		}
+	}
+	si->querying = 0;
+}
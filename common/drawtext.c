@@ -0,0 +1,102 @@
+// 18 october 2026
+#include <stdint.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// This file provides basic utilities in case the platform doesn't provide any of its own for text tasks.
+// Like the ones in matrix.c, keep these minimal; they should only be built on top of the public API.
+
+void uiprivFallbackMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights)
+{
+	uiAttributedString *s;
+	uiDrawTextLayoutParams p;
+	uiDrawTextLayout *tl;
+	double width, height;
+	size_t i;
+
+	// TODO const-correct uiDrawTextLayoutParams
+	p.DefaultFont = (uiFontDescriptor *) desc;
+	p.Width = -1;
+	p.Align = uiDrawTextAlignLeft;
+	for (i = 0; i < n; i++) {
+		s = uiNewAttributedString(strings[i]);
+		p.String = s;
+		tl = uiDrawNewTextLayout(&p);
+		uiDrawTextLayoutExtents(tl, &width, &height);
+		uiDrawFreeTextLayout(tl);
+		uiFreeAttributedString(s);
+		if (widths != NULL)
+			widths[i] = width;
+		if (heights != NULL)
+			heights[i] = height;
+	}
+}
+
+// without a platform-specific implementation we can't do the work in the background, but we can at least keep the contract that f is called later on the main thread
+// uiQueueMain() can't be cancelled, so what's queued is an ID instead of the structure itself; uiprivUninitFallbackTextLayouts() frees the structures, and a queued call that no longer finds its ID does nothing
+struct fallbackAsyncLayout {
+	uiDrawTextLayout *tl;
+	void (*f)(uiDrawTextLayout *tl, void *data);
+	void *data;
+	uintptr_t id;
+	struct fallbackAsyncLayout *next;
+};
+
+static struct fallbackAsyncLayout *fallbackAsyncLayouts = NULL;
+// this isn't reset by uiUninit(), so calls queued before then can't match layouts made after the next uiInit()
+static uintptr_t nextFallbackAsyncLayoutID = 0;
+
+static void fallbackAsyncLayoutDone(void *data)
+{
+	uintptr_t id = (uintptr_t) data;
+	struct fallbackAsyncLayout **pp;
+	struct fallbackAsyncLayout *al;
+
+	for (pp = &fallbackAsyncLayouts; *pp != NULL; pp = &((*pp)->next))
+		if ((*pp)->id == id)
+			break;
+	al = *pp;
+	if (al == NULL)
+		return;
+	*pp = al->next;
+	(*(al->f))(al->tl, al->data);
+	uiprivFree(al);
+}
+
+void uiprivFallbackNewTextLayoutAsync(uiDrawTextLayoutParams *p, void (*f)(uiDrawTextLayout *tl, void *data), void *data)
+{
+	struct fallbackAsyncLayout *al;
+
+	al = uiprivNew(struct fallbackAsyncLayout);
+	al->tl = uiDrawNewTextLayout(p);
+	al->f = f;
+	al->data = data;
+	al->id = nextFallbackAsyncLayoutID++;
+	al->next = fallbackAsyncLayouts;
+	fallbackAsyncLayouts = al;
+	uiQueueMain(fallbackAsyncLayoutDone, (void *) (al->id));
+}
+
+void uiprivUninitFallbackTextLayouts(void)
+{
+	struct fallbackAsyncLayout *al;
+
+	while (fallbackAsyncLayouts != NULL) {
+		al = fallbackAsyncLayouts;
+		fallbackAsyncLayouts = al->next;
+		uiDrawFreeTextLayout(al->tl);
+		uiprivFree(al);
+	}
+}
+
+// this is the same idea as Pango's approximate character width: the average width of a representative sample of text
+#define avgCharWidthSample "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+double uiprivFallbackAverageCharWidth(const uiFontDescriptor *desc)
+{
+	const char *sample = avgCharWidthSample;
+	double width;
+
+	uiDrawMeasureTexts(desc, &sample, 1, &width, NULL);
+	return width / (sizeof (avgCharWidthSample) - 1);
+}
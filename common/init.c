@@ -0,0 +1,14 @@
+// 18 october 2026
+#include <stddef.h>
+#include "../ui.h"
+#include "uipriv.h"
+
+// programs built against an older ui.h pass a smaller uiInitOptions, and Size says how big theirs is
+// so only copy the fields they actually have; the rest stay 0, which is the old behavior
+void uiprivLoadInitOptions(const uiInitOptions *o)
+{
+	memset(&uiprivOptions, 0, sizeof (uiInitOptions));
+	uiprivOptions.Size = o->Size;
+	if (o->Size >= offsetof(uiInitOptions, Flags) + sizeof (o->Flags))
+		uiprivOptions.Flags = o->Flags;
+}
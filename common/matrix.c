@@ -3,6 +3,17 @@
 #include "../ui.h"
 #include "uipriv.h"
 
+// SSE2 is always there on x86-64, and MSVC doesn't define __SSE2__
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define matrixSSE2
+#include <emmintrin.h>
+#endif
+// AVX needs to be turned on at build time (for instance with -mavx or /arch:AVX); we don't check for it at runtime
+#ifdef __AVX__
+#define matrixAVX
+#include <immintrin.h>
+#endif
+
 void uiDrawMatrixSetIdentity(uiDrawMatrix *m)
 {
 	m->M11 = 1;
@@ -13,6 +24,116 @@ void uiDrawMatrixSetIdentity(uiDrawMatrix *m)
 	m->M32 = 0;
 }
 
+// these do the same arithmetic in the same order as the scalar loops at the end, so all three agree (unless the compiler fuses the scalar multiplies and adds)
+// each point is x * (M11, M12) + y * (M21, M22) + (M31, M32)
+
+void uiDrawMatrixTransformPoints(uiDrawMatrix *m, double *xy, size_t n)
+{
+	size_t i;
+	double x, y;
+
+	i = 0;
+#ifdef matrixAVX
+	{
+		__m256d c0, c1, c2;
+		__m256d v, xx, yy;
+
+		c0 = _mm256_setr_pd(m->M11, m->M12, m->M11, m->M12);
+		c1 = _mm256_setr_pd(m->M21, m->M22, m->M21, m->M22);
+		c2 = _mm256_setr_pd(m->M31, m->M32, m->M31, m->M32);
+		// two points at a time
+		for (; i + 2 <= n; i += 2) {
+			v = _mm256_loadu_pd(xy + 2 * i);
+			xx = _mm256_unpacklo_pd(v, v);
+			yy = _mm256_unpackhi_pd(v, v);
+			v = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(xx, c0), _mm256_mul_pd(yy, c1)), c2);
+			_mm256_storeu_pd(xy + 2 * i, v);
+		}
+	}
+#endif
+#ifdef matrixSSE2
+	{
+		__m128d c0, c1, c2;
+		__m128d v, xx, yy;
+
+		c0 = _mm_setr_pd(m->M11, m->M12);
+		c1 = _mm_setr_pd(m->M21, m->M22);
+		c2 = _mm_setr_pd(m->M31, m->M32);
+		for (; i < n; i++) {
+			v = _mm_loadu_pd(xy + 2 * i);
+			xx = _mm_unpacklo_pd(v, v);
+			yy = _mm_unpackhi_pd(v, v);
+			v = _mm_add_pd(_mm_add_pd(_mm_mul_pd(xx, c0), _mm_mul_pd(yy, c1)), c2);
+			_mm_storeu_pd(xy + 2 * i, v);
+		}
+	}
+#endif
+	for (; i < n; i++) {
+		x = xy[2 * i];
+		y = xy[2 * i + 1];
+		xy[2 * i] = m->M11 * x + m->M21 * y + m->M31;
+		xy[2 * i + 1] = m->M12 * x + m->M22 * y + m->M32;
+	}
+}
+
+void uiDrawMatrixTransformPointsFloat(uiDrawMatrix *m, float *xy, size_t n)
+{
+	size_t i;
+	float m11, m12, m21, m22, m31, m32;
+	float x, y;
+
+	// the matrix is rounded once up front, so every path below uses the same coefficients
+	m11 = (float) (m->M11);
+	m12 = (float) (m->M12);
+	m21 = (float) (m->M21);
+	m22 = (float) (m->M22);
+	m31 = (float) (m->M31);
+	m32 = (float) (m->M32);
+	i = 0;
+#ifdef matrixAVX
+	{
+		__m256 c0, c1, c2;
+		__m256 v, xx, yy;
+
+		c0 = _mm256_setr_ps(m11, m12, m11, m12, m11, m12, m11, m12);
+		c1 = _mm256_setr_ps(m21, m22, m21, m22, m21, m22, m21, m22);
+		c2 = _mm256_setr_ps(m31, m32, m31, m32, m31, m32, m31, m32);
+		// four points at a time
+		for (; i + 4 <= n; i += 4) {
+			v = _mm256_loadu_ps(xy + 2 * i);
+			xx = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+			yy = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+			v = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xx, c0), _mm256_mul_ps(yy, c1)), c2);
+			_mm256_storeu_ps(xy + 2 * i, v);
+		}
+	}
+#endif
+#ifdef matrixSSE2
+	{
+		__m128 c0, c1, c2;
+		__m128 v, xx, yy;
+
+		c0 = _mm_setr_ps(m11, m12, m11, m12);
+		c1 = _mm_setr_ps(m21, m22, m21, m22);
+		c2 = _mm_setr_ps(m31, m32, m31, m32);
+		// two points at a time
+		for (; i + 2 <= n; i += 2) {
+			v = _mm_loadu_ps(xy + 2 * i);
+			xx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+			yy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+			v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, c0), _mm_mul_ps(yy, c1)), c2);
+			_mm_storeu_ps(xy + 2 * i, v);
+		}
+	}
+#endif
+	for (; i < n; i++) {
+		x = xy[2 * i];
+		y = xy[2 * i + 1];
+		xy[2 * i] = m11 * x + m21 * y + m31;
+		xy[2 * i + 1] = m12 * x + m22 * y + m32;
+	}
+}
+
 // The rest of this file provides basic utilities in case the platform doesn't provide any of its own for these tasks.
 // Keep these as minimal as possible. They should generally not call other fallbacks.
 
@@ -11,6 +11,11 @@ extern "C" {
 
 // OS-specific init.* or main.* files
 extern uiInitOptions uiprivOptions;
+// only needed by OSs that use areaanimation.c; this is in seconds, from an arbitrary starting point
+extern double uiprivMonotonicTime(void);
+
+// init.c
+extern void uiprivLoadInitOptions(const uiInitOptions *o);
 
 // OS-specific alloc.* files
 extern void *uiprivAlloc(size_t, const char *);
@@ -58,6 +63,23 @@ extern int uiprivFromScancode(uintptr_t, uiAreaKeyEvent *);
 extern void uiprivFallbackSkew(uiDrawMatrix *, double, double, double, double);
 extern void uiprivFallbackTransformSize(uiDrawMatrix *, double *, double *);
 
+// draw.c
+extern void uiprivCopyBrush(uiDrawBrush *dst, const uiDrawBrush *src);
+extern void uiprivFreeBrushCopy(uiDrawBrush *b);
+extern void uiprivFallbackFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b);
+extern void uiprivFallbackFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n);
+extern double uiprivStrokeOutset(const uiDrawStrokeParams *p);
+
+// drawtext.c
+extern void uiprivFallbackMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights);
+extern void uiprivFallbackNewTextLayoutAsync(uiDrawTextLayoutParams *p, void (*f)(uiDrawTextLayout *tl, void *data), void *data);
+extern void uiprivUninitFallbackTextLayouts(void);
+extern double uiprivFallbackAverageCharWidth(const uiFontDescriptor *desc);
+
+// areaanimation.c
+extern void uiprivFallbackSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data);
+extern void uiprivUninitAreaAnimation(void);
+
 // OS-specific text.* files
 extern int uiprivStricmp(const char *a, const char *b);
 
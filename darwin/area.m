@@ -364,6 +364,7 @@ static void uiAreaDestroy(uiControl *c)
 {
 	uiArea *a = uiArea(c);
 
+	uiprivFallbackSetAnimationCallback(a, NULL, NULL);
 	if (a->scrolling)
 		uiprivScrollViewFreeData(a->sv, a->d);
 	[a->area release];
@@ -420,6 +421,21 @@ void uiAreaQueueRedrawAll(uiArea *a)
 	[a->area setNeedsDisplay:YES];
 }
 
+void uiAreaQueueRedrawRect(uiArea *a, double x, double y, double width, double height)
+{
+	// areaView is flipped, so these are already in the right coordinates
+	// Cocoa unions these together until the next drawRect:
+	[a->area setNeedsDisplayInRect:NSMakeRect(x, y, width, height)];
+}
+
+void uiAreaQueueRedrawRects(uiArea *a, const double *rects, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++, rects += 4)
+		uiAreaQueueRedrawRect(a, rects[0], rects[1], rects[2], rects[3]);
+}
+
 void uiAreaScrollTo(uiArea *a, double x, double y, double width, double height)
 {
 	if (!a->scrolling)
@@ -428,6 +444,42 @@ void uiAreaScrollTo(uiArea *a, double x, double y, double width, double height)
 	// don't worry about the return value; it just says whether scrolling was needed
 }
 
+// NSScrollView already copies what's on screen when scrolling and only asks us to draw what's newly exposed
+void uiAreaSetBackingStore(uiArea *a, int enabled, double margin)
+{
+	if (!a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetBackingStore() on a non-scrolling uiArea. (area: %p)", a);
+}
+
+double uiAreaScaleFactor(uiArea *a)
+{
+	NSWindow *w;
+
+	w = [a->area window];
+	if (w == nil)
+		return [[NSScreen mainScreen] backingScaleFactor];
+	return [w backingScaleFactor];
+}
+
+// TODO use CVDisplayLink to line up with the display
+void uiAreaSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data)
+{
+	uiprivFallbackSetAnimationCallback(a, f, data);
+}
+
+// TODO tiled rendering; for now Draw is always called once on the main thread, which a thread-safe Draw handler is fine with
+void uiAreaSetTiledRendering(uiArea *a, int tileSize, int threads)
+{
+	// do nothing
+}
+
+// TODO use NSView's live resize support (-inLiveResize, -viewDidEndLiveResize) for uiAreaResizeDeferred and -preservesContentDuringLiveResize for uiAreaResizeRedrawExposed
+void uiAreaSetResizePolicy(uiArea *a, uiAreaResizePolicy policy)
+{
+	if (a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetResizePolicy() on a scrolling uiArea. (area: %p)", a);
+}
+
 void uiAreaBeginUserWindowMove(uiArea *a)
 {
 	uiprivNSWindow *w;
@@ -5,4 +5,5 @@
 struct uiDrawContext {
 	CGContextRef c;
 	CGFloat height;				// needed for text; see below
+	uiDrawStats stats;
 };
@@ -99,6 +99,19 @@ void uiDrawPathAddRectangle(uiDrawPath *p, double x, double y, double width, dou
 	CGPathAddRect(p->path, NULL, CGRectMake(x, y, width, height));
 }
 
+void uiDrawPathAddPolyline(uiDrawPath *p, const double *xy, size_t n)
+{
+	size_t i;
+
+	if (p->ended)
+		uiprivUserBug("You cannot call uiDrawPathAddPolyline() on a uiDrawPath that has already been ended. (path: %p)", p);
+	if (n == 0)
+		return;
+	CGPathMoveToPoint(p->path, NULL, xy[0], xy[1]);
+	for (i = 1; i < n; i++)
+		CGPathAddLineToPoint(p->path, NULL, xy[2 * i], xy[2 * i + 1]);
+}
+
 void uiDrawPathEnd(uiDrawPath *p)
 {
 	p->ended = TRUE;
@@ -109,6 +122,31 @@ int uiDrawPathEnded(uiDrawPath *p)
 	return p->ended == TRUE ? 1 : 0;
 }
 
+// TODO see if there's a way to keep the memory of the old path around
+void uiDrawPathReset(uiDrawPath *p)
+{
+	CGPathRelease((CGPathRef) (p->path));
+	p->path = CGPathCreateMutable();
+	p->ended = NO;
+}
+
+int uiDrawPathBounds(uiDrawPath *p, double *x, double *y, double *width, double *height)
+{
+	CGRect r;
+
+	if (!p->ended)
+		uiprivUserBug("You cannot call uiDrawPathBounds() on a uiDrawPath that has not been ended. (path: %p)", p);
+	if (CGPathIsEmpty((CGPathRef) (p->path)))
+		return 0;
+	// this includes the control points of curves, which is fine for our purposes and faster than CGPathGetPathBoundingBox()
+	r = CGPathGetBoundingBox((CGPathRef) (p->path));
+	*x = r.origin.x;
+	*y = r.origin.y;
+	*width = r.size.width;
+	*height = r.size.height;
+	return 1;
+}
+
 uiDrawContext *uiprivDrawNewContext(CGContextRef ctxt, CGFloat height)
 {
 	uiDrawContext *c;
@@ -124,20 +162,16 @@ void uiprivDrawFreeContext(uiDrawContext *c)
 	uiprivFree(c);
 }
 
-// a stroke is identical to a fill of a stroked path
-// we need to do this in order to stroke with a gradient; see http://stackoverflow.com/a/25034854/3408572
-// doing this for other brushes works too
-void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p)
+// this returns the outline of stroking path with p, which the caller must release
+// it's shared by uiDrawStroke() and uiDrawPathStrokeContainsPoint() so the two always agree
+static CGPathRef strokedPath(uiDrawPath *path, uiDrawStrokeParams *p)
 {
 	CGLineCap cap;
 	CGLineJoin join;
 	CGPathRef dashPath;
+	CGPathRef stroked;
 	CGFloat *dashes;
 	size_t i;
-	uiDrawPath p2;
-
-	if (!path->ended)
-		uiprivUserBug("You cannot call uiDrawStroke() on a uiDrawPath that has not been ended. (path: %p)", path);
 
 	switch (p->Cap) {
 	case uiDrawLineCapFlat:
@@ -176,8 +210,7 @@ void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStro
 		uiprivFree(dashes);
 	}
 	// the documentation is wrong: this produces a path suitable for calling CGPathCreateCopyByStrokingPath(), not for filling directly
-	// the cast is safe; we never modify the CGPathRef and always cast it back to a CGPathRef anyway
-	p2.path = (CGMutablePathRef) CGPathCreateCopyByStrokingPath(dashPath,
+	stroked = CGPathCreateCopyByStrokingPath(dashPath,
 		NULL,
 		p->Thickness,
 		cap,
@@ -185,16 +218,75 @@ void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStro
 		p->MiterLimit);
 	if (p->NumDashes != 0)
 		CGPathRelease(dashPath);
+	return stroked;
+}
+
+// Core Graphics still strokes and rasterizes paths that miss the clip before throwing the result away, and we stroke paths ourselves (see below), so skip those
+// both rectangles are in user space; if the transform rotates, CGContextGetClipBoundingBox() is the bounding box of the rotated clip, so this never culls anything visible
+static BOOL culled(uiDrawContext *c, uiDrawPath *path, double outset)
+{
+	CGRect r, clip;
+
+	if (!CGPathIsEmpty((CGPathRef) (path->path))) {
+		// as with uiDrawPathBounds(), the control points are fine here
+		r = CGRectInset(CGPathGetBoundingBox((CGPathRef) (path->path)), -outset, -outset);
+		clip = CGContextGetClipBoundingBox(c->c);
+		if (CGRectGetMaxX(r) > CGRectGetMinX(clip) && CGRectGetMinX(r) < CGRectGetMaxX(clip) &&
+			CGRectGetMaxY(r) > CGRectGetMinY(clip) && CGRectGetMinY(r) < CGRectGetMaxY(clip))
+			return NO;
+	}
+	c->stats.CulledOperations++;
+	return YES;
+}
+
+static void fill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b);
+
+// a stroke is identical to a fill of a stroked path
+// we need to do this in order to stroke with a gradient; see http://stackoverflow.com/a/25034854/3408572
+// doing this for other brushes works too
+void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p)
+{
+	uiDrawPath p2;
+
+	if (!path->ended)
+		uiprivUserBug("You cannot call uiDrawStroke() on a uiDrawPath that has not been ended. (path: %p)", path);
+	if (culled(c, path, uiprivStrokeOutset(p)))
+		return;
 
+	// the cast is safe; we never modify the CGPathRef and always cast it back to a CGPathRef anyway
+	p2.path = (CGMutablePathRef) strokedPath(path, p);
 	// always draw stroke fills using the winding rule
 	// otherwise intersecting figures won't draw correctly
 	p2.fillMode = uiDrawFillModeWinding;
 	p2.ended = path->ended;
-	uiDrawFill(c, &p2, b);
+	fill(c, &p2, b);
 	// and clean up
 	CGPathRelease((CGPathRef) (p2.path));
 }
 
+int uiDrawPathContainsPoint(uiDrawPath *p, double x, double y)
+{
+	if (!p->ended)
+		uiprivUserBug("You cannot call uiDrawPathContainsPoint() on a uiDrawPath that has not been ended. (path: %p)", p);
+	return CGPathContainsPoint((CGPathRef) (p->path), NULL,
+		CGPointMake(x, y),
+		p->fillMode == uiDrawFillModeAlternate) ? 1 : 0;
+}
+
+int uiDrawPathStrokeContainsPoint(uiDrawPath *p, double x, double y, uiDrawStrokeParams *sp)
+{
+	CGPathRef stroked;
+	bool contains;
+
+	if (!p->ended)
+		uiprivUserBug("You cannot call uiDrawPathStrokeContainsPoint() on a uiDrawPath that has not been ended. (path: %p)", p);
+	stroked = strokedPath(p, sp);
+	// as in uiDrawStroke(), stroke outlines are always filled with the winding rule
+	contains = CGPathContainsPoint(stroked, NULL, CGPointMake(x, y), false);
+	CGPathRelease(stroked);
+	return contains ? 1 : 0;
+}
+
 // for a solid fill, we can merely have Core Graphics fill directly
 static void fillSolid(CGContextRef ctxt, uiDrawPath *p, uiDrawBrush *b)
 {
@@ -282,10 +374,8 @@ static void fillGradient(CGContextRef ctxt, uiDrawPath *p, uiDrawBrush *b)
 	CGColorSpaceRelease(colorspace);
 }
 
-void uiDrawFill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b)
+static void fill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b)
 {
-	if (!path->ended)
-		uiprivUserBug("You cannot call uiDrawStroke() on a uiDrawPath that has not been ended. (path: %p)", path);
 	CGContextAddPath(c->c, (CGPathRef) (path->path));
 	switch (b->Type) {
 	case uiDrawBrushTypeSolid:
@@ -302,6 +392,55 @@ void uiDrawFill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b)
 	uiprivUserBug("Unknown brush type %d passed to uiDrawFill().", b->Type);
 }
 
+void uiDrawFill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b)
+{
+	if (!path->ended)
+		uiprivUserBug("You cannot call uiDrawFill() on a uiDrawPath that has not been ended. (path: %p)", path);
+	if (culled(c, path, 0))
+		return;
+	fill(c, path, b);
+}
+
+// TODO keep the native brush around too; Direct2D brushes belong to a render target and Core Graphics gradients depend on the path, so for now this only saves copying the brush
+struct uiDrawCachedBrush {
+	uiDrawBrush b;
+};
+
+uiDrawCachedBrush *uiDrawNewBrush(const uiDrawBrush *b)
+{
+	uiDrawCachedBrush *cb;
+
+	cb = uiprivNew(uiDrawCachedBrush);
+	uiprivCopyBrush(&(cb->b), b);
+	return cb;
+}
+
+void uiDrawFreeBrush(uiDrawCachedBrush *b)
+{
+	uiprivFreeBrushCopy(&(b->b));
+	uiprivFree(b);
+}
+
+void uiDrawStrokeCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b, uiDrawStrokeParams *p)
+{
+	uiDrawStroke(c, path, &(b->b), p);
+}
+
+void uiDrawFillCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b)
+{
+	uiDrawFill(c, path, &(b->b));
+}
+
+void uiDrawFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b)
+{
+	uiprivFallbackFillRects(c, rects, n, b);
+}
+
+void uiDrawFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n)
+{
+	uiprivFallbackFillRectsColored(c, rects, colors, n);
+}
+
 static void m2c(uiDrawMatrix *m, CGAffineTransform *c)
 {
 	c->a = m->M11;
@@ -445,6 +584,12 @@ void uiDrawClip(uiDrawContext *c, uiDrawPath *path)
 }
 
 // TODO figure out what besides transforms these save/restore on all platforms
+// TODO keep some of these
+void uiDrawContextStats(uiDrawContext *c, uiDrawStats *s)
+{
+	*s = c->stats;
+}
+
 void uiDrawSave(uiDrawContext *c)
 {
 	CGContextSaveGState(c->c);
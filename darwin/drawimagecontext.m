@@ -0,0 +1,83 @@
+// 18 october 2026
+#import "uipriv_darwin.h"
+#import "draw.h"
+
+struct uiDrawImageContext {
+	CGContextRef bitmap;
+	uiDrawContext *c;
+};
+
+uiDrawImageContext *uiDrawNewImageContext(double width, double height, double scale)
+{
+	uiDrawImageContext *ic;
+	CGColorSpaceRef colorspace;
+
+	if (scale <= 0)
+		uiprivUserBug("You cannot create a uiDrawImageContext with a scale of %g.", scale);
+	ic = uiprivNew(uiDrawImageContext);
+	colorspace = CGColorSpaceCreateDeviceRGB();
+	// this is the 0xAARRGGBB that uiDrawImageContextPixels() promises; CoreGraphics allocates the memory and clears it to transparent for us
+	ic->bitmap = CGBitmapContextCreate(NULL,
+		(size_t) ceil(width * scale), (size_t) ceil(height * scale),
+		8, 0, colorspace,
+		kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+	CGColorSpaceRelease(colorspace);
+	if (ic->bitmap == NULL)
+		uiprivImplBug("error creating uiDrawImageContext bitmap");
+	// flip it the same way as a uiDrawCachedLayer, so (0, 0) is the top-left corner and the first row of pixels is the top of the image
+	CGContextTranslateCTM(ic->bitmap, 0, CGBitmapContextGetHeight(ic->bitmap));
+	CGContextScaleCTM(ic->bitmap, scale, -scale);
+	ic->c = uiprivDrawNewContext(ic->bitmap, height);
+	return ic;
+}
+
+void uiDrawFreeImageContext(uiDrawImageContext *ic)
+{
+	uiprivDrawFreeContext(ic->c);
+	CGContextRelease(ic->bitmap);
+	uiprivFree(ic);
+}
+
+uiDrawContext *uiDrawImageContextContext(uiDrawImageContext *ic)
+{
+	return ic->c;
+}
+
+void uiDrawImageContextClear(uiDrawImageContext *ic)
+{
+	CGContextSaveGState(ic->bitmap);
+	// undo whatever transform is in effect so we clear the whole bitmap in pixels
+	CGContextConcatCTM(ic->bitmap, CGAffineTransformInvert(CGContextGetCTM(ic->bitmap)));
+	CGContextClearRect(ic->bitmap, CGRectMake(0, 0,
+		CGBitmapContextGetWidth(ic->bitmap), CGBitmapContextGetHeight(ic->bitmap)));
+	CGContextRestoreGState(ic->bitmap);
+}
+
+const uint8_t *uiDrawImageContextPixels(uiDrawImageContext *ic, int *width, int *height, int *stride)
+{
+	CGContextFlush(ic->bitmap);
+	*width = (int) CGBitmapContextGetWidth(ic->bitmap);
+	*height = (int) CGBitmapContextGetHeight(ic->bitmap);
+	*stride = (int) CGBitmapContextGetBytesPerRow(ic->bitmap);
+	return (const uint8_t *) CGBitmapContextGetData(ic->bitmap);
+}
+
+int uiDrawImageContextWritePNG(uiDrawImageContext *ic, const char *filename)
+{
+	CGImageRef image;
+	NSBitmapImageRep *rep;
+	NSData *data;
+	BOOL ok;
+
+	image = CGBitmapContextCreateImage(ic->bitmap);
+	if (image == NULL)
+		return 0;
+	rep = [[NSBitmapImageRep alloc] initWithCGImage:image];
+	CGImageRelease(image);
+	data = [rep representationUsingType:NSPNGFileType properties:[NSDictionary dictionary]];
+	ok = NO;
+	if (data != nil)
+		ok = [data writeToFile:uiprivToNSString(filename) atomically:NO];
+	[rep release];
+	return ok == YES ? 1 : 0;
+}
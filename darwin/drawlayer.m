@@ -0,0 +1,101 @@
+// 18 october 2026
+#import "uipriv_darwin.h"
+#import "draw.h"
+
+struct uiDrawCachedLayer {
+	double width;
+	double height;
+	double scale;
+	CGContextRef bitmap;
+	// this is made from bitmap the first time the layer is drawn after being drawn into
+	CGImageRef image;
+	uiDrawContext *c;
+	BOOL valid;
+};
+
+uiDrawCachedLayer *uiDrawNewLayer(double width, double height, double scale)
+{
+	uiDrawCachedLayer *l;
+	CGColorSpaceRef colorspace;
+
+	if (scale <= 0)
+		uiprivUserBug("You cannot create a uiDrawCachedLayer with a scale of %g.", scale);
+	l = uiprivNew(uiDrawCachedLayer);
+	l->width = width;
+	l->height = height;
+	l->scale = scale;
+	colorspace = CGColorSpaceCreateDeviceRGB();
+	l->bitmap = CGBitmapContextCreate(NULL,
+		(size_t) ceil(width * scale), (size_t) ceil(height * scale),
+		8, 0, colorspace,
+		kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+	CGColorSpaceRelease(colorspace);
+	if (l->bitmap == NULL)
+		uiprivImplBug("error creating uiDrawCachedLayer bitmap");
+	return l;
+}
+
+static void freeImage(uiDrawCachedLayer *l)
+{
+	if (l->image != NULL)
+		CGImageRelease(l->image);
+	l->image = NULL;
+}
+
+void uiDrawFreeLayer(uiDrawCachedLayer *l)
+{
+	if (l->c != NULL)
+		uiprivUserBug("You cannot free a uiDrawCachedLayer that is being drawn into. (layer: %p)", l);
+	freeImage(l);
+	CGContextRelease(l->bitmap);
+	uiprivFree(l);
+}
+
+uiDrawContext *uiDrawLayerBegin(uiDrawCachedLayer *l)
+{
+	if (l->c != NULL)
+		uiprivUserBug("You cannot call uiDrawLayerBegin() on a uiDrawCachedLayer that is already being drawn into. (layer: %p)", l);
+	freeImage(l);
+	CGContextClearRect(l->bitmap, CGRectMake(0, 0,
+		CGBitmapContextGetWidth(l->bitmap), CGBitmapContextGetHeight(l->bitmap)));
+	CGContextSaveGState(l->bitmap);
+	// areas are flipped views, so flip the layer the same way for the drawing code
+	CGContextTranslateCTM(l->bitmap, 0, CGBitmapContextGetHeight(l->bitmap));
+	CGContextScaleCTM(l->bitmap, l->scale, -l->scale);
+	l->c = uiprivDrawNewContext(l->bitmap, l->height);
+	return l->c;
+}
+
+void uiDrawLayerEnd(uiDrawCachedLayer *l)
+{
+	if (l->c == NULL)
+		uiprivUserBug("You cannot call uiDrawLayerEnd() without first calling uiDrawLayerBegin(). (layer: %p)", l);
+	uiprivDrawFreeContext(l->c);
+	l->c = NULL;
+	CGContextRestoreGState(l->bitmap);
+	l->valid = YES;
+}
+
+void uiDrawLayerInvalidate(uiDrawCachedLayer *l)
+{
+	l->valid = NO;
+}
+
+int uiDrawLayerValid(uiDrawCachedLayer *l)
+{
+	return l->valid == YES ? 1 : 0;
+}
+
+void uiDrawLayer(uiDrawContext *c, uiDrawCachedLayer *l, double x, double y)
+{
+	if (l->c == c)
+		uiprivUserBug("You cannot draw a uiDrawCachedLayer into itself. (layer: %p)", l);
+	if (l->image == NULL)
+		l->image = CGBitmapContextCreateImage(l->bitmap);
+	CGContextSaveGState(c->c);
+	// c is flipped, so we have to flip the image back or it will be drawn upside down
+	CGContextTranslateCTM(c->c, x, y + l->height);
+	CGContextScaleCTM(c->c, 1, -1);
+	CGContextDrawImage(c->c, CGRectMake(0, 0, l->width, l->height), l->image);
+	CGContextRestoreGState(c->c);
+}
@@ -0,0 +1,78 @@
+// 18 october 2026
+#import "uipriv_darwin.h"
+#import "draw.h"
+
+struct uiDrawPixelBuffer {
+	int width;
+	int height;
+	uint8_t *pixels;
+	BOOL writing;
+};
+
+uiDrawPixelBuffer *uiDrawNewPixelBuffer(int width, int height)
+{
+	uiDrawPixelBuffer *pb;
+
+	if (width <= 0 || height <= 0)
+		uiprivUserBug("You cannot create a uiDrawPixelBuffer of size %dx%d.", width, height);
+	pb = uiprivNew(uiDrawPixelBuffer);
+	pb->width = width;
+	pb->height = height;
+	// uiprivAlloc() zeroes this for us, so it starts out transparent
+	pb->pixels = (uint8_t *) uiprivAlloc(width * height * 4, "uint8_t[]");
+	return pb;
+}
+
+void uiDrawFreePixelBuffer(uiDrawPixelBuffer *pb)
+{
+	uiprivFree(pb->pixels);
+	uiprivFree(pb);
+}
+
+uint8_t *uiDrawPixelBufferBegin(uiDrawPixelBuffer *pb, int *stride)
+{
+	if (pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferBegin() on a uiDrawPixelBuffer that is already being written to. (pixel buffer: %p)", pb);
+	pb->writing = YES;
+	*stride = pb->width * 4;
+	return pb->pixels;
+}
+
+void uiDrawPixelBufferEnd(uiDrawPixelBuffer *pb, int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight)
+{
+	if (!pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferEnd() without first calling uiDrawPixelBufferBegin(). (pixel buffer: %p)", pb);
+	// nothing is cached between calls to uiDrawPixels(), so there's nothing to do with the dirty rectangle
+	pb->writing = NO;
+}
+
+void uiDrawPixels(uiDrawContext *c, uiDrawPixelBuffer *pb, double x, double y, double width, double height)
+{
+	CGDataProviderRef provider;
+	CGColorSpaceRef colorspace;
+	CGImageRef image;
+
+	if (pb->writing)
+		uiprivUserBug("You cannot draw a uiDrawPixelBuffer that is being written to. (pixel buffer: %p)", pb);
+	if (width <= 0 || height <= 0)
+		return;
+	// this doesn't copy the pixels; the image only lives until the end of this function, so it can't see them change
+	provider = CGDataProviderCreateWithData(NULL, pb->pixels, pb->width * pb->height * 4, NULL);
+	colorspace = CGColorSpaceCreateDeviceRGB();
+	image = CGImageCreate(pb->width, pb->height,
+		8, 32, pb->width * 4,
+		colorspace,
+		kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host,
+		provider, NULL, false, kCGRenderingIntentDefault);
+	CGColorSpaceRelease(colorspace);
+	CGDataProviderRelease(provider);
+	if (image == NULL)
+		uiprivImplBug("error creating image for uiDrawPixelBuffer");
+	CGContextSaveGState(c->c);
+	// c is flipped, so we have to flip the image back or it will be drawn upside down
+	CGContextTranslateCTM(c->c, x, y + height);
+	CGContextScaleCTM(c->c, 1, -1);
+	CGContextDrawImage(c->c, CGRectMake(0, 0, width, height), image);
+	CGContextRestoreGState(c->c);
+	CGImageRelease(image);
+}
@@ -187,6 +187,12 @@ uiDrawTextLayout *uiDrawNewTextLayout(uiDrawTextLayoutParams *p)
 	return tl;
 }
 
+// TODO do the layout on a background thread
+void uiDrawNewTextLayoutAsync(uiDrawTextLayoutParams *p, void (*f)(uiDrawTextLayout *tl, void *data), void *data)
+{
+	uiprivFallbackNewTextLayoutAsync(p, f, data);
+}
+
 void uiDrawFreeTextLayout(uiDrawTextLayout *tl)
 {
 	uiprivFree(tl->u16tou8);
@@ -213,6 +219,28 @@ void uiDrawTextLayoutExtents(uiDrawTextLayout *tl, double *width, double *height
 	[tl->forLines returnWidth:NULL height:height];
 }
 
+// TODO reuse a single CTFontRef for the whole batch
+void uiDrawMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights)
+{
+	uiprivFallbackMeasureTexts(desc, strings, n, widths, heights);
+}
+
+// NSFontManager already caches this for us
+void uiListFontFamilies(uiListFontFamiliesFunc f, void *data)
+{
+	NSString *family;
+
+	for (family in [[NSFontManager sharedFontManager] availableFontFamilies])
+		if ((*f)([family UTF8String], data) == uiForEachStop)
+			break;
+}
+
+// uiInitFlagWarmUpFonts does nothing here yet
+int uiFontWarmUpStats(double *seconds)
+{
+	return 0;
+}
+
 void uiLoadControlFont(uiFontDescriptor *f)
 {
 	CTFontRef ctfont;
@@ -225,6 +253,33 @@ void uiLoadControlFont(uiFontDescriptor *f)
 	f->Size = CTFontGetSize(ctfont);
 }
 
+void uiFontMetrics(const uiFontDescriptor *desc, double *ascent, double *descent, double *lineHeight, double *avgCharWidth)
+{
+	CTFontDescriptorRef ctdesc;
+	CTFontRef font;
+	CGFloat fascent, fdescent, fleading;
+
+	// TODO const-correct uiprivFontDescriptorToCTFontDescriptor()
+	ctdesc = uiprivFontDescriptorToCTFontDescriptor((uiFontDescriptor *) desc);
+	font = CTFontCreateWithFontDescriptor(ctdesc, desc->Size, NULL);
+	CFRelease(ctdesc);
+	fascent = CTFontGetAscent(font);
+	fdescent = CTFontGetDescent(font);
+	fleading = CTFontGetLeading(font);
+	CFRelease(font);
+
+	if (ascent != NULL)
+		*ascent = fascent;
+	if (descent != NULL)
+		*descent = fdescent;
+	// this is how Core Text computes the height of a line
+	if (lineHeight != NULL)
+		*lineHeight = fascent + fdescent + fleading;
+	// Core Text has no equivalent of this
+	if (avgCharWidth != NULL)
+		*avgCharWidth = uiprivFallbackAverageCharWidth(desc);
+}
+
 void uiFreeFontDescriptor(uiFontDescriptor *desc)
 {
 	// TODO ensure this is synchronized with fontmatch.m
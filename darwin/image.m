@@ -1,5 +1,6 @@
 // 25 june 2016
 #import "uipriv_darwin.h"
+#import "draw.h"
 
 struct uiImage {
 	NSImage *i;
@@ -82,3 +83,38 @@ NSImage *uiprivImageNSImage(uiImage *i)
 {
 	return i->i;
 }
+
+static const CGInterpolationQuality interpolations[] = {
+	[uiDrawImageFilterNearest] = kCGInterpolationNone,
+	[uiDrawImageFilterLinear] = kCGInterpolationLow,
+	[uiDrawImageFilterSmooth] = kCGInterpolationHigh,
+};
+
+// Core Graphics already keeps decoded and resampled copies of the images it draws, so unlike the other platforms there's no cache here
+void uiDrawImage(uiDrawContext *c, uiImage *i, double x, double y, double width, double height, uiDrawImageFilter filter)
+{
+	CGSize device;
+	NSRect proposed;
+	CGImageRef image;
+
+	if ([[i->i representations] count] == 0)
+		uiprivUserBug("You cannot draw a uiImage that has no representations. (image: %p)", i);
+	if (width <= 0 || height <= 0)
+		return;
+
+	// with no context to go by, NSImage picks the representation closest to the proposed size in pixels, so hand it the size in device pixels
+	device = CGContextConvertSizeToDeviceSpace(c->c, CGSizeMake(width, height));
+	proposed = NSMakeRect(0, 0, ceil(fabs(device.width)), ceil(fabs(device.height)));
+	// this is owned by the NSImage; don't release it
+	image = [i->i CGImageForProposedRect:&proposed context:nil hints:nil];
+	if (image == NULL)
+		uiprivImplBug("error getting CGImage for uiImage");
+
+	CGContextSaveGState(c->c);
+	CGContextSetInterpolationQuality(c->c, interpolations[filter]);
+	// c is flipped, so we have to flip the image back or it will be drawn upside down
+	CGContextTranslateCTM(c->c, x, y + height);
+	CGContextScaleCTM(c->c, 1, -1);
+	CGContextDrawImage(c->c, CGRectMake(0, 0, width, height), image);
+	CGContextRestoreGState(c->c);
+}
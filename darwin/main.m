@@ -113,7 +113,7 @@ uiInitOptions uiprivOptions;
 const char *uiInit(uiInitOptions *o)
 {
 	@autoreleasepool {
-		uiprivOptions = *o;
+		uiprivLoadInitOptions(o);
 		app = [[uiprivApplicationClass sharedApplication] retain];
 		// don't check for a NO return; something (launch services?) causes running from application bundles to always return NO when asking to change activation policy, even if the change is to the same activation policy!
 		// see https://github.com/andlabs/ui/issues/6
@@ -147,6 +147,8 @@ void uiUninit(void)
 
 	@autoreleasepool {
 		uiprivUninitUnderlineColors();
+		uiprivUninitAreaAnimation();
+		uiprivUninitFallbackTextLayouts();
 		[delegate release];
 		[uiprivNSApp() setDelegate:nil];
 		[app release];
@@ -285,5 +287,10 @@ void uiTimer(int milliseconds, int (*f)(void *data), void *data)
         [delegate release];
 }
 
+double uiprivMonotonicTime(void)
+{
+	return [[NSProcessInfo processInfo] systemUptime];
+}
+
 // TODO figure out the best way to clean the above up in uiUninit(), if it's even necessary
 // TODO that means figure out if timers can still fire without the main loop
@@ -0,0 +1,74 @@
+// 18 october 2026
+#ifndef __LIBUI_BENCH_H__
+#define __LIBUI_BENCH_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../ui.h"
+// for runDrawTest() and drawTestName() from test/drawtests.c
+#include "../test.h"
+
+// main.c
+extern double benchNow(void);
+extern int benchWanted(const char *name);
+extern void benchRun(const char *name, int iterations, void (*f)(void *data), void *data);
+extern void benchSetCounter(const char *name, double value);
+
+// brush.c
+extern void benchBrush(void);
+extern void benchFreeBrush(void);
+
+// draw.c
+#define benchDrawWidth 640
+#define benchDrawHeight 480
+struct benchDrawCase {
+	const char *name;
+	int iterations;
+	void (*f)(uiAreaDrawParams *p, void *data);
+	void *data;
+};
+extern void benchInitDraw(void);
+extern void benchUninitDraw(void);
+extern void benchRunDraw(const char *name, int iterations, void (*f)(uiAreaDrawParams *p, void *data), void *data);
+extern void benchQueueAreaDraw(const char *name, int iterations, void (*f)(uiAreaDrawParams *p, void *data), void *data);
+extern void benchRunQueuedAreaDraws(void);
+extern void benchSetSolidBrush(uiDrawBrush *b, double r, double g, double bl, double a);
+extern void benchSetStrokeParams(uiDrawStrokeParams *sp, double thickness);
+
+// image.c
+extern void benchImage(void);
+extern void benchFreeImage(void);
+
+// layer.c
+extern void benchLayer(void);
+extern void benchFreeLayer(void);
+
+// list.c
+extern void benchList(void);
+extern void benchFreeList(void);
+
+// matrix.c
+extern void benchMatrix(void);
+
+// path.c
+#define benchPathSegments 1000000
+extern void benchPath(void);
+
+// pixels.c
+extern void benchPixels(void);
+extern void benchFreePixels(void);
+
+// points.c
+extern void benchPoints(void);
+extern void benchFreePoints(void);
+
+// scenarios.c
+extern void benchDrawTests(void);
+
+// state.c
+extern void benchState(void);
+extern void benchFreeState(void);
+
+#endif
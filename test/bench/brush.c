@@ -0,0 +1,73 @@
+// 18 october 2026
+#include "bench.h"
+
+#define nFills 10000
+
+static uiDrawBrushGradientStop stops[] = {
+	{ 0.0, 1.0, 0.0, 0.0, 1.0 },
+	{ 0.25, 1.0, 1.0, 0.0, 1.0 },
+	{ 0.5, 0.0, 1.0, 0.0, 1.0 },
+	{ 0.75, 0.0, 0.0, 1.0, 1.0 },
+	{ 1.0, 1.0, 0.0, 1.0, 1.0 },
+};
+
+static uiDrawBrush gradient;
+static uiDrawPath *cell;
+
+static void fillGradient(uiAreaDrawParams *p, void *data)
+{
+	int i;
+
+	for (i = 0; i < nFills; i++)
+		uiDrawFill(p->Context, cell, &gradient);
+}
+
+static void fillCachedGradient(uiAreaDrawParams *p, void *data)
+{
+	uiDrawCachedBrush *b;
+	int i;
+
+	b = uiDrawNewBrush(&gradient);
+	for (i = 0; i < nFills; i++)
+		uiDrawFillCachedBrush(p->Context, cell, b);
+	uiDrawFreeBrush(b);
+}
+
+// the same few solid colors, as a chart with a legend would use them
+static void fillSolids(uiAreaDrawParams *p, void *data)
+{
+	uiDrawBrush b;
+	int i;
+
+	benchSetSolidBrush(&b, 0, 0, 0.5, 1);
+	for (i = 0; i < nFills; i++) {
+		b.R = (i % 4) / 4.0;
+		b.G = (i % 3) / 3.0;
+		uiDrawFill(p->Context, cell, &b);
+	}
+}
+
+void benchBrush(void)
+{
+	memset(&gradient, 0, sizeof (uiDrawBrush));
+	gradient.Type = uiDrawBrushTypeLinearGradient;
+	gradient.X0 = 0;
+	gradient.Y0 = 0;
+	gradient.X1 = 32;
+	gradient.Y1 = 32;
+	gradient.Stops = stops;
+	gradient.NumStops = sizeof (stops) / sizeof (stops[0]);
+
+	cell = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathAddRectangle(cell, 0, 0, 32, 32);
+	uiDrawPathEnd(cell);
+
+	benchRunDraw("brush/gradient-10k", 5, fillGradient, NULL);
+	benchRunDraw("brush/cached-gradient-10k", 5, fillCachedGradient, NULL);
+	benchRunDraw("brush/solid-10k", 5, fillSolids, NULL);
+}
+
+void benchFreeBrush(void)
+{
+	uiDrawFreePath(cell);
+}
@@ -0,0 +1,158 @@
+// 18 october 2026
+#include "bench.h"
+
+// most drawing benchmarks draw into a uiDrawImageContext, which needs no window and no trip through the main loop
+// the few that measure drawing into a uiArea itself are queued up here and run from the first Draw of an area in a window
+
+#define maxAreaDrawCases 16
+
+static uiDrawImageContext *ic;
+static uiAreaDrawParams dp;
+
+static struct benchDrawCase areaDrawCases[maxAreaDrawCases];
+static int nAreaDrawCases = 0;
+static int drawn = 0;
+
+struct drawRun {
+	struct benchDrawCase *bc;
+	uiAreaDrawParams *p;
+};
+
+void benchInitDraw(void)
+{
+	ic = uiDrawNewImageContext(benchDrawWidth, benchDrawHeight, 1);
+	memset(&dp, 0, sizeof (uiAreaDrawParams));
+	dp.Context = uiDrawImageContextContext(ic);
+	dp.AreaWidth = benchDrawWidth;
+	dp.AreaHeight = benchDrawHeight;
+	dp.ClipWidth = benchDrawWidth;
+	dp.ClipHeight = benchDrawHeight;
+}
+
+void benchUninitDraw(void)
+{
+	uiDrawFreeImageContext(ic);
+}
+
+static void runDrawCase(void *data)
+{
+	struct drawRun *r = (struct drawRun *) data;
+
+	(*(r->bc->f))(r->p, r->bc->data);
+}
+
+static void runDraw(struct benchDrawCase *bc, uiAreaDrawParams *p)
+{
+	struct drawRun r;
+
+	r.bc = bc;
+	r.p = p;
+	// each iteration draws over the last; save and restore so one iteration's state doesn't leak into the next
+	uiDrawSave(p->Context);
+	benchRun(bc->name, bc->iterations, runDrawCase, &r);
+	uiDrawRestore(p->Context);
+}
+
+void benchRunDraw(const char *name, int iterations, void (*f)(uiAreaDrawParams *p, void *data), void *data)
+{
+	struct benchDrawCase bc;
+
+	bc.name = name;
+	bc.iterations = iterations;
+	bc.f = f;
+	bc.data = data;
+	runDraw(&bc, &dp);
+}
+
+void benchQueueAreaDraw(const char *name, int iterations, void (*f)(uiAreaDrawParams *p, void *data), void *data)
+{
+	// don't open a window just for benchmarks that won't run
+	if (!benchWanted(name))
+		return;
+	if (nAreaDrawCases == maxAreaDrawCases) {
+		fprintf(stderr, "too many uiArea drawing benchmarks; increase maxAreaDrawCases\n");
+		abort();
+	}
+	areaDrawCases[nAreaDrawCases].name = name;
+	areaDrawCases[nAreaDrawCases].iterations = iterations;
+	areaDrawCases[nAreaDrawCases].f = f;
+	areaDrawCases[nAreaDrawCases].data = data;
+	nAreaDrawCases++;
+}
+
+// most of the drawing benchmarks only need a plain color and a plain line
+void benchSetSolidBrush(uiDrawBrush *b, double r, double g, double bl, double a)
+{
+	memset(b, 0, sizeof (uiDrawBrush));
+	b->Type = uiDrawBrushTypeSolid;
+	b->R = r;
+	b->G = g;
+	b->B = bl;
+	b->A = a;
+}
+
+void benchSetStrokeParams(uiDrawStrokeParams *sp, double thickness)
+{
+	memset(sp, 0, sizeof (uiDrawStrokeParams));
+	sp->Cap = uiDrawLineCapFlat;
+	sp->Join = uiDrawLineJoinMiter;
+	sp->Thickness = thickness;
+	sp->MiterLimit = uiDrawDefaultMiterLimit;
+}
+
+static void handlerDraw(uiAreaHandler *ah, uiArea *a, uiAreaDrawParams *p)
+{
+	int i;
+
+	if (drawn)
+		return;
+	drawn = 1;
+	for (i = 0; i < nAreaDrawCases; i++)
+		runDraw(&(areaDrawCases[i]), p);
+	uiQuit();
+}
+
+static void handlerMouseEvent(uiAreaHandler *ah, uiArea *a, uiAreaMouseEvent *e)
+{
+}
+
+static void handlerMouseCrossed(uiAreaHandler *ah, uiArea *a, int left)
+{
+}
+
+static void handlerDragBroken(uiAreaHandler *ah, uiArea *a)
+{
+}
+
+static int handlerKeyEvent(uiAreaHandler *ah, uiArea *a, uiAreaKeyEvent *e)
+{
+	return 0;
+}
+
+static int onClosing(uiWindow *w, void *data)
+{
+	uiQuit();
+	return 1;
+}
+
+void benchRunQueuedAreaDraws(void)
+{
+	uiAreaHandler handler;
+	uiWindow *w;
+	uiArea *a;
+
+	if (nAreaDrawCases == 0)
+		return;
+	handler.Draw = handlerDraw;
+	handler.MouseEvent = handlerMouseEvent;
+	handler.MouseCrossed = handlerMouseCrossed;
+	handler.DragBroken = handlerDragBroken;
+	handler.KeyEvent = handlerKeyEvent;
+	w = uiNewWindow("libui benchmarks", benchDrawWidth, benchDrawHeight, 0);
+	uiWindowOnClosing(w, onClosing, NULL);
+	a = uiNewArea(&handler);
+	uiWindowSetChild(w, uiControl(a));
+	uiControlShow(uiControl(w));
+	uiMain();
+	uiControlDestroy(uiControl(w));
+}
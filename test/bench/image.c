@@ -0,0 +1,59 @@
+// 18 october 2026
+#include "bench.h"
+
+// the same scene drawn into a uiArea and into a uiDrawImageContext, which needs no window and no trip through the main loop
+
+#define cellSize 8
+
+static uiDrawImageContext *ic;
+
+static void drawCells(uiDrawContext *c)
+{
+	uiDrawBrush b;
+	uiDrawPath *path;
+	int x, y;
+
+	benchSetSolidBrush(&b, 0, 0, 0.5, 1);
+	for (y = 0; y < benchDrawHeight; y += cellSize)
+		for (x = 0; x < benchDrawWidth; x += cellSize) {
+			b.R = ((double) x) / benchDrawWidth;
+			b.G = ((double) y) / benchDrawHeight;
+			path = uiDrawNewPath(uiDrawFillModeWinding);
+			uiDrawPathAddRectangle(path, x, y, cellSize - 1, cellSize - 1);
+			uiDrawPathEnd(path);
+			uiDrawFill(c, path, &b);
+			uiDrawFreePath(path);
+		}
+}
+
+static void drawArea(uiAreaDrawParams *p, void *data)
+{
+	drawCells(p->Context);
+}
+
+static void drawImage(void *data)
+{
+	uiDrawImageContextClear(ic);
+	drawCells(uiDrawImageContextContext(ic));
+}
+
+static void drawImagePixels(void *data)
+{
+	int width, height, stride;
+
+	drawImage(data);
+	uiDrawImageContextPixels(ic, &width, &height, &stride);
+}
+
+void benchImage(void)
+{
+	ic = uiDrawNewImageContext(benchDrawWidth, benchDrawHeight, 1);
+	benchRun("image/cells", 20, drawImage, NULL);
+	benchRun("image/cells-and-pixels", 20, drawImagePixels, NULL);
+	benchQueueAreaDraw("image/cells-in-area", 20, drawArea, NULL);
+}
+
+void benchFreeImage(void)
+{
+	uiDrawFreeImageContext(ic);
+}
@@ -0,0 +1,61 @@
+// 18 october 2026
+#include "bench.h"
+
+// a static background (here a fine grid, as under a chart) redrawn every frame, against drawing it once into a layer and compositing that
+
+#define gridSpacing 4
+
+static uiDrawPath *grid;
+static uiDrawCachedLayer *layer;
+
+static void strokeGrid(uiDrawContext *c)
+{
+	uiDrawBrush b;
+	uiDrawStrokeParams sp;
+
+	benchSetSolidBrush(&b, 0.8, 0.8, 0.8, 1);
+	benchSetStrokeParams(&sp, 0.5);
+	uiDrawStroke(c, grid, &b, &sp);
+}
+
+static void drawGrid(uiAreaDrawParams *p, void *data)
+{
+	strokeGrid(p->Context);
+}
+
+static void drawLayer(uiAreaDrawParams *p, void *data)
+{
+	uiDrawLayer(p->Context, layer, 0, 0);
+}
+
+void benchLayer(void)
+{
+	uiDrawContext *c;
+	int i;
+
+	grid = uiDrawNewPath(uiDrawFillModeWinding);
+	for (i = 0; i <= benchDrawWidth; i += gridSpacing) {
+		uiDrawPathNewFigure(grid, i, 0);
+		uiDrawPathLineTo(grid, i, benchDrawHeight);
+	}
+	for (i = 0; i <= benchDrawHeight; i += gridSpacing) {
+		uiDrawPathNewFigure(grid, 0, i);
+		uiDrawPathLineTo(grid, benchDrawWidth, i);
+	}
+	uiDrawPathEnd(grid);
+
+	// there's no uiArea to ask for the scale factor yet, so just use 1
+	layer = uiDrawNewLayer(benchDrawWidth, benchDrawHeight, 1);
+	c = uiDrawLayerBegin(layer);
+	strokeGrid(c);
+	uiDrawLayerEnd(layer);
+
+	benchRunDraw("layer/stroke-grid", 20, drawGrid, NULL);
+	benchRunDraw("layer/composite-grid", 20, drawLayer, NULL);
+}
+
+void benchFreeLayer(void)
+{
+	uiDrawFreeLayer(layer);
+	uiDrawFreePath(grid);
+}
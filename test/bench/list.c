@@ -0,0 +1,59 @@
+// 18 october 2026
+#include "bench.h"
+
+// a static scene of many small shapes, as in a map or a schematic, redrawn either in full or for a small damaged area
+
+#define nShapes 20000
+#define shapeSize 4
+
+static uiDrawPath *shapes[nShapes];
+static uiDrawBrush brush;
+static uiDrawList *list;
+
+static void drawImmediate(uiAreaDrawParams *p, void *data)
+{
+	int i;
+
+	for (i = 0; i < nShapes; i++)
+		uiDrawFill(p->Context, shapes[i], &brush);
+}
+
+static void drawList(uiAreaDrawParams *p, void *data)
+{
+	uiDrawListDraw(p->Context, list, 0, 0, benchDrawWidth, benchDrawHeight);
+}
+
+static void drawListDamaged(uiAreaDrawParams *p, void *data)
+{
+	// as if only a 64x64 area needed redrawing
+	uiDrawListDraw(p->Context, list, 100, 100, 64, 64);
+}
+
+void benchList(void)
+{
+	int i;
+	double x, y;
+
+	benchSetSolidBrush(&brush, 0, 0.5, 0, 1);
+	list = uiDrawNewList();
+	for (i = 0; i < nShapes; i++) {
+		x = (i % 160) * shapeSize;
+		y = (i / 160) * shapeSize;
+		shapes[i] = uiDrawNewPath(uiDrawFillModeWinding);
+		uiDrawPathNewFigureWithArc(shapes[i], x + shapeSize / 2.0, y + shapeSize / 2.0, shapeSize / 2.0 - 0.5, 0, 2 * uiPi, 0);
+		uiDrawPathEnd(shapes[i]);
+		uiDrawListFill(list, shapes[i], &brush);
+	}
+	benchRunDraw("list/immediate-20k", 5, drawImmediate, NULL);
+	benchRunDraw("list/replay-20k", 5, drawList, NULL);
+	benchRunDraw("list/replay-20k-damaged-64x64", 5, drawListDamaged, NULL);
+}
+
+void benchFreeList(void)
+{
+	int i;
+
+	uiDrawFreeList(list);
+	for (i = 0; i < nShapes; i++)
+		uiDrawFreePath(shapes[i]);
+}
@@ -0,0 +1,256 @@
+// 18 october 2026
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include "bench.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+static const char *filter = NULL;
+static int json = 0;
+static int nResults = 0;
+// an extra number a benchmark can report along with its times; see benchSetCounter()
+static const char *counterName = NULL;
+static double counterValue;
+
+// to count allocations, we replace malloc() and friends for the whole process, including cairo, pango, and GLib, and pass the calls on to glibc
+// this only works with glibc, and would bypass a sanitizer's own malloc(), so everywhere else allocations aren't counted
+#if defined(__SANITIZE_ADDRESS__)
+#define benchNoAllocations
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define benchNoAllocations
+#endif
+#endif
+#if defined(__GLIBC__) && !defined(benchNoAllocations)
+#define benchCountAllocations
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+
+static size_t allocations = 0;
+
+void *malloc(size_t size)
+{
+	__atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+	__atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+	return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size)
+{
+	__atomic_fetch_add(&allocations, 1, __ATOMIC_RELAXED);
+	return __libc_realloc(p, size);
+}
+
+static size_t benchAllocations(void)
+{
+	return __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+}
+#endif
+
+// returns seconds from an arbitrary starting point
+double benchNow(void)
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return ((double) (now.QuadPart)) / ((double) (freq.QuadPart));
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double) (ts.tv_sec)) + ((double) (ts.tv_nsec)) / 1e9;
+#endif
+}
+
+// this attaches a named number (such as a uiDrawStats counter) to the result of the benchmark that's running; if it's called on every run, the last call wins
+void benchSetCounter(const char *name, double value)
+{
+	counterName = name;
+	counterValue = value;
+}
+
+static int compareTimes(const void *a, const void *b)
+{
+	double ta = *((const double *) a);
+	double tb = *((const double *) b);
+
+	if (ta < tb)
+		return -1;
+	if (ta > tb)
+		return 1;
+	return 0;
+}
+
+// nearest-rank percentile of sorted times
+static double percentile(const double *times, int n, int p)
+{
+	int i;
+
+	i = (n * p + 99) / 100 - 1;
+	if (i < 0)
+		i = 0;
+	return times[i];
+}
+
+static void printJSONString(const char *s)
+{
+	putchar('"');
+	for (; *s != '\0'; s++) {
+		if (*s == '"' || *s == '\\')
+			putchar('\\');
+		putchar(*s);
+	}
+	putchar('"');
+}
+
+static void report(const char *name, int iterations, double *times, double allocs)
+{
+	double total;
+	int i;
+
+	qsort(times, iterations, sizeof (double), compareTimes);
+	total = 0;
+	for (i = 0; i < iterations; i++)
+		total += times[i];
+	if (!json) {
+		printf("%-40s %6d runs  mean %10.3f ms  p50 %10.3f ms  p99 %10.3f ms",
+			name, iterations,
+			total / iterations * 1000,
+			percentile(times, iterations, 50) * 1000,
+			percentile(times, iterations, 99) * 1000);
+		if (allocs >= 0)
+			printf("  %10.0f allocs", allocs);
+		if (counterName != NULL)
+			printf("  %10.0f %s", counterValue, counterName);
+		printf("\n");
+		fflush(stdout);
+		return;
+	}
+	printf(nResults == 0 ? "[\n" : ",\n");
+	printf("  { \"name\": ");
+	printJSONString(name);
+	printf(", \"iterations\": %d, \"mean_ms\": %.6f, \"p50_ms\": %.6f, \"p99_ms\": %.6f, \"min_ms\": %.6f, \"allocations\": ",
+		iterations,
+		total / iterations * 1000,
+		percentile(times, iterations, 50) * 1000,
+		percentile(times, iterations, 99) * 1000,
+		times[0] * 1000);
+	if (allocs >= 0)
+		printf("%.1f", allocs);
+	else
+		printf("null");
+	if (counterName != NULL) {
+		printf(", ");
+		printJSONString(counterName);
+		printf(": %.1f", counterValue);
+	}
+	printf(" }");
+	fflush(stdout);
+}
+
+int benchWanted(const char *name)
+{
+	return filter == NULL || strstr(name, filter) != NULL;
+}
+
+// allocations are reported as the mean per run, or -1 if they can't be counted
+void benchRun(const char *name, int iterations, void (*f)(void *data), void *data)
+{
+	double start;
+	double *times;
+	double allocs;
+	int i;
+#ifdef benchCountAllocations
+	size_t startAllocs;
+#endif
+
+	if (!benchWanted(name))
+		return;
+	times = (double *) malloc(iterations * sizeof (double));
+	if (times == NULL) {
+		fprintf(stderr, "memory exhausted allocating benchmark times\n");
+		abort();
+	}
+	allocs = -1;
+	counterName = NULL;
+#ifdef benchCountAllocations
+	startAllocs = benchAllocations();
+#endif
+	for (i = 0; i < iterations; i++) {
+		start = benchNow();
+		(*f)(data);
+		times[i] = benchNow() - start;
+	}
+#ifdef benchCountAllocations
+	allocs = ((double) (benchAllocations() - startAllocs)) / iterations;
+#endif
+	report(name, iterations, times, allocs);
+	nResults++;
+	free(times);
+}
+
+int main(int argc, char *argv[])
+{
+	uiInitOptions o;
+	const char *err;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) {
+			json = 1;
+			continue;
+		}
+		if (filter != NULL || argv[i][0] == '-') {
+			fprintf(stderr, "usage: %s [--json] [filter]\n", argv[0]);
+			return 1;
+		}
+		filter = argv[i];
+	}
+
+	memset(&o, 0, sizeof (uiInitOptions));
+	err = uiInit(&o);
+	if (err != NULL) {
+		fprintf(stderr, "error initializing ui: %s\n", err);
+		uiFreeInitError(err);
+		return 1;
+	}
+
+	benchInitDraw();
+	benchPath();
+	benchMatrix();
+	benchPoints();
+	benchBrush();
+	benchState();
+	benchList();
+	benchLayer();
+	benchImage();
+	benchPixels();
+	benchDrawTests();
+	benchRunQueuedAreaDraws();
+	benchFreePixels();
+	benchFreeImage();
+	benchFreeLayer();
+	benchFreeList();
+	benchFreeState();
+	benchFreeBrush();
+	benchFreePoints();
+	benchUninitDraw();
+
+	if (json)
+		printf(nResults == 0 ? "[]\n" : "\n]\n");
+	uiUninit();
+	return 0;
+}
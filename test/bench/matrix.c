@@ -0,0 +1,52 @@
+// 18 october 2026
+#include "bench.h"
+
+// projecting a dataset to screen space, one point at a time against all at once
+
+#define nMatrixPoints 1000000
+
+static uiDrawMatrix m;
+static double *xy = NULL;
+static float *xyf = NULL;
+
+static void transformEach(void *data)
+{
+	size_t i;
+
+	for (i = 0; i < nMatrixPoints; i++)
+		uiDrawMatrixTransformPoint(&m, &(xy[2 * i]), &(xy[2 * i + 1]));
+}
+
+static void transformAll(void *data)
+{
+	uiDrawMatrixTransformPoints(&m, xy, nMatrixPoints);
+}
+
+static void transformAllFloat(void *data)
+{
+	uiDrawMatrixTransformPointsFloat(&m, xyf, nMatrixPoints);
+}
+
+void benchMatrix(void)
+{
+	size_t i;
+
+	xy = (double *) malloc(2 * nMatrixPoints * sizeof (double));
+	xyf = (float *) malloc(2 * nMatrixPoints * sizeof (float));
+	if (xy == NULL || xyf == NULL) {
+		fprintf(stderr, "memory exhausted allocating benchmark data\n");
+		abort();
+	}
+	for (i = 0; i < 2 * nMatrixPoints; i++) {
+		xy[i] = (double) (i % 1000);
+		xyf[i] = (float) (i % 1000);
+	}
+	// close enough to identity that repeated runs don't overflow
+	uiDrawMatrixSetIdentity(&m);
+	uiDrawMatrixRotate(&m, 500, 500, 0.001);
+	benchRun("matrix/transform-each-1M", 10, transformEach, NULL);
+	benchRun("matrix/transform-points-1M", 10, transformAll, NULL);
+	benchRun("matrix/transform-points-float-1M", 10, transformAllFloat, NULL);
+	free(xyf);
+	free(xy);
+}
@@ -0,0 +1,75 @@
+// 18 october 2026
+#include "bench.h"
+
+// a sawtooth, so the path is made of lines that actually go somewhere
+static void buildLines(uiDrawPath *p, int n)
+{
+	int i;
+
+	uiDrawPathNewFigure(p, 0, 0);
+	for (i = 1; i <= n; i++)
+		uiDrawPathLineTo(p, i * 0.001, (double) (i % 100));
+	uiDrawPathEnd(p);
+}
+
+static void newPathLines(void *data)
+{
+	uiDrawPath *p;
+
+	p = uiDrawNewPath(uiDrawFillModeWinding);
+	buildLines(p, benchPathSegments);
+	uiDrawFreePath(p);
+}
+
+static void resetPathLines(void *data)
+{
+	uiDrawPath *p = (uiDrawPath *) data;
+
+	uiDrawPathReset(p);
+	buildLines(p, benchPathSegments);
+}
+
+static void newPathCurves(void *data)
+{
+	uiDrawPath *p;
+	int i;
+
+	p = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathNewFigure(p, 0, 0);
+	for (i = 1; i <= benchPathSegments; i++)
+		uiDrawPathBezierTo(p,
+			i * 0.001 - 0.0007, 10,
+			i * 0.001 - 0.0003, -10,
+			i * 0.001, 0);
+	uiDrawPathEnd(p);
+	uiDrawFreePath(p);
+}
+
+static void newPathArcs(void *data)
+{
+	uiDrawPath *p;
+	int i;
+
+	p = uiDrawNewPath(uiDrawFillModeWinding);
+	// arcs are much more expensive for the platform to flatten, so use fewer of them
+	for (i = 0; i < benchPathSegments / 10; i++)
+		uiDrawPathNewFigureWithArc(p,
+			(i % 1000) * 10, (i / 1000) * 10, 4,
+			0, 2 * uiPi, 0);
+	uiDrawPathEnd(p);
+	uiDrawFreePath(p);
+}
+
+// uiDrawPathEnd() prepares the path for drawing, so these measure both construction and replay
+void benchPath(void)
+{
+	uiDrawPath *p;
+
+	benchRun("path/new-1M-lines", 10, newPathLines, NULL);
+	p = uiDrawNewPath(uiDrawFillModeWinding);
+	buildLines(p, benchPathSegments);
+	benchRun("path/reset-1M-lines", 10, resetPathLines, p);
+	uiDrawFreePath(p);
+	benchRun("path/new-1M-curves", 10, newPathCurves, NULL);
+	benchRun("path/new-100k-arcs", 10, newPathArcs, NULL);
+}
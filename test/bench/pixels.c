@@ -0,0 +1,59 @@
+// 18 october 2026
+#include "bench.h"
+
+// a software renderer writing a whole frame of pixels and showing it, as a spectrogram or video would
+
+static uiDrawPixelBuffer *pb;
+
+static void writeFrame(int frame)
+{
+	uint8_t *pixels;
+	uint32_t *row;
+	int stride;
+	int x, y;
+
+	pixels = uiDrawPixelBufferBegin(pb, &stride);
+	for (y = 0; y < benchDrawHeight; y++) {
+		row = (uint32_t *) (pixels + y * stride);
+		for (x = 0; x < benchDrawWidth; x++)
+			row[x] = 0xFF000000 | (((x + frame) & 0xFF) << 16) | ((y & 0xFF) << 8) | (frame & 0xFF);
+	}
+	uiDrawPixelBufferEnd(pb, 0, 0, benchDrawWidth, benchDrawHeight);
+}
+
+static void drawFrames(uiAreaDrawParams *p, void *data)
+{
+	static int frame = 0;
+
+	writeFrame(frame);
+	frame++;
+	uiDrawPixels(p->Context, pb, 0, 0, benchDrawWidth, benchDrawHeight);
+}
+
+// only a column changes per frame, as with a scrolling waveform
+static void drawColumns(uiAreaDrawParams *p, void *data)
+{
+	static int column = 0;
+	uint8_t *pixels;
+	int stride;
+	int y;
+
+	pixels = uiDrawPixelBufferBegin(pb, &stride);
+	for (y = 0; y < benchDrawHeight; y++)
+		*((uint32_t *) (pixels + y * stride + column * 4)) = 0xFFFFFFFF;
+	uiDrawPixelBufferEnd(pb, column, 0, 1, benchDrawHeight);
+	column = (column + 1) % benchDrawWidth;
+	uiDrawPixels(p->Context, pb, 0, 0, benchDrawWidth, benchDrawHeight);
+}
+
+void benchPixels(void)
+{
+	pb = uiDrawNewPixelBuffer(benchDrawWidth, benchDrawHeight);
+	benchRunDraw("pixels/full-frame", 60, drawFrames, NULL);
+	benchRunDraw("pixels/one-column", 60, drawColumns, NULL);
+}
+
+void benchFreePixels(void)
+{
+	uiDrawFreePixelBuffer(pb);
+}
@@ -0,0 +1,159 @@
+// 18 october 2026
+#include "bench.h"
+
+// these compare drawing lots of points the way examples/histogram does (one call per element) against the batched functions
+
+#define nPoints 1000000
+#define nRects 100000
+
+static double *xy = NULL;
+// the same points as xy, split up the way uiDrawPathAddDecimatedSeries() wants them
+static double *xs = NULL;
+static double *ys = NULL;
+static double *rects = NULL;
+static double *colors = NULL;
+
+static void strokeLine(uiAreaDrawParams *p, uiDrawPath *path)
+{
+	uiDrawBrush b;
+	uiDrawStrokeParams sp;
+
+	benchSetSolidBrush(&b, 0.12, 0.56, 1.0, 1.0);
+	benchSetStrokeParams(&sp, 1);
+	uiDrawStroke(p->Context, path, &b, &sp);
+}
+
+static void lineToEach(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path;
+	int i;
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathNewFigure(path, xy[0], xy[1]);
+	for (i = 1; i < nPoints; i++)
+		uiDrawPathLineTo(path, xy[2 * i], xy[2 * i + 1]);
+	uiDrawPathEnd(path);
+	strokeLine(p, path);
+	uiDrawFreePath(path);
+}
+
+static void polyline(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path;
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathAddPolyline(path, xy, nPoints);
+	uiDrawPathEnd(path);
+	strokeLine(p, path);
+	uiDrawFreePath(path);
+}
+
+static void decimated(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path;
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathAddDecimatedSeries(path, xs, ys, nPoints, NULL, 1);
+	uiDrawPathEnd(path);
+	strokeLine(p, path);
+	uiDrawFreePath(path);
+}
+
+static void fillEachRect(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path;
+	uiDrawBrush b;
+	int i;
+
+	benchSetSolidBrush(&b, 0.12, 0.56, 1.0, 0.5);
+	for (i = 0; i < nRects; i++) {
+		path = uiDrawNewPath(uiDrawFillModeWinding);
+		uiDrawPathAddRectangle(path, rects[4 * i], rects[4 * i + 1], rects[4 * i + 2], rects[4 * i + 3]);
+		uiDrawPathEnd(path);
+		uiDrawFill(p->Context, path, &b);
+		uiDrawFreePath(path);
+	}
+}
+
+static void fillRects(uiAreaDrawParams *p, void *data)
+{
+	uiDrawBrush b;
+
+	benchSetSolidBrush(&b, 0.12, 0.56, 1.0, 0.5);
+	uiDrawFillRects(p->Context, rects, nRects, &b);
+}
+
+static void fillEachRectColored(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path;
+	uiDrawBrush b;
+	int i;
+
+	for (i = 0; i < nRects; i++) {
+		benchSetSolidBrush(&b, colors[4 * i], colors[4 * i + 1], colors[4 * i + 2], colors[4 * i + 3]);
+		path = uiDrawNewPath(uiDrawFillModeWinding);
+		uiDrawPathAddRectangle(path, rects[4 * i], rects[4 * i + 1], rects[4 * i + 2], rects[4 * i + 3]);
+		uiDrawPathEnd(path);
+		uiDrawFill(p->Context, path, &b);
+		uiDrawFreePath(path);
+	}
+}
+
+static void fillRectsColored(uiAreaDrawParams *p, void *data)
+{
+	uiDrawFillRectsColored(p->Context, rects, colors, nRects);
+}
+
+static void makeData(void)
+{
+	int i;
+
+	xy = (double *) malloc(2 * nPoints * sizeof (double));
+	rects = (double *) malloc(4 * nRects * sizeof (double));
+	colors = (double *) malloc(4 * nRects * sizeof (double));
+	xs = (double *) malloc(nPoints * sizeof (double));
+	ys = (double *) malloc(nPoints * sizeof (double));
+	if (xy == NULL || rects == NULL || colors == NULL || xs == NULL || ys == NULL) {
+		fprintf(stderr, "memory exhausted allocating benchmark data\n");
+		abort();
+	}
+	srand(1);
+	for (i = 0; i < nPoints; i++) {
+		xy[2 * i] = ((double) i) * benchDrawWidth / nPoints;
+		xy[2 * i + 1] = ((double) rand()) / RAND_MAX * benchDrawHeight;
+		xs[i] = xy[2 * i];
+		ys[i] = xy[2 * i + 1];
+	}
+	// a heatmap: a grid of cells, with colors in runs of 10 like a quantized palette would give
+	for (i = 0; i < nRects; i++) {
+		rects[4 * i] = (i % 400) * 1.5;
+		rects[4 * i + 1] = (i / 400) * 1.5;
+		rects[4 * i + 2] = 1.5;
+		rects[4 * i + 3] = 1.5;
+		colors[4 * i] = ((i / 10) % 8) / 8.0;
+		colors[4 * i + 1] = 0.5;
+		colors[4 * i + 2] = 1.0 - colors[4 * i];
+		colors[4 * i + 3] = 1.0;
+	}
+}
+
+void benchPoints(void)
+{
+	makeData();
+	benchRunDraw("points/lineto-1M", 5, lineToEach, NULL);
+	benchRunDraw("points/polyline-1M", 5, polyline, NULL);
+	benchRunDraw("points/decimated-1M", 5, decimated, NULL);
+	benchRunDraw("rects/fill-each-100k", 3, fillEachRect, NULL);
+	benchRunDraw("rects/fillrects-100k", 3, fillRects, NULL);
+	benchRunDraw("rects/fill-each-colored-100k", 3, fillEachRectColored, NULL);
+	benchRunDraw("rects/fillrectscolored-100k", 3, fillRectsColored, NULL);
+}
+
+void benchFreePoints(void)
+{
+	free(ys);
+	free(xs);
+	free(colors);
+	free(rects);
+	free(xy);
+}
@@ -0,0 +1,165 @@
+// 18 october 2026
+#include "bench.h"
+
+// the scenarios from test/drawtests.c plus some stress scenarios
+// use bench --json drawtests/ and bench --json stress/ to track these across releases
+
+#define drawTestIterations 100
+#define stressSegments 1000000
+#define stressRects 100000
+#define stressGradients 10000
+#define stressTextRepeats 200
+
+// the tests change the transform and clip freely, so give each run a clean slate
+static void runTest(uiAreaDrawParams *p, void *data)
+{
+	int n = *((int *) data);
+
+	uiDrawSave(p->Context);
+	runDrawTest(n, p);
+	uiDrawRestore(p->Context);
+}
+
+// one figure zigzagging across the whole image, so every segment is visible and the stroker can't skip any of it
+static void strokeSegments(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path = (uiDrawPath *) data;
+	uiDrawBrush b;
+	uiDrawStrokeParams sp;
+
+	benchSetSolidBrush(&b, 0.12, 0.56, 1.0, 1.0);
+	benchSetStrokeParams(&sp, 1);
+	uiDrawStroke(p->Context, path, &b, &sp);
+}
+
+static void fillRects(uiAreaDrawParams *p, void *data)
+{
+	uiDrawPath *path = (uiDrawPath *) data;
+	uiDrawBrush b;
+
+	benchSetSolidBrush(&b, 0.12, 0.56, 1.0, 0.5);
+	uiDrawFill(p->Context, path, &b);
+}
+
+static void fillGradients(uiAreaDrawParams *p, void *data)
+{
+	uiDrawBrush b;
+	uiDrawBrushGradientStop stops[3];
+	uiDrawPath *path;
+	double x, y;
+	int i;
+
+	memset(stops, 0, 3 * sizeof (uiDrawBrushGradientStop));
+	stops[0].Pos = 0;
+	stops[0].R = 1;
+	stops[0].A = 1;
+	stops[1].Pos = 0.5;
+	stops[1].G = 1;
+	stops[1].A = 0.5;
+	stops[2].Pos = 1;
+	stops[2].B = 1;
+	stops[2].A = 1;
+	memset(&b, 0, sizeof (uiDrawBrush));
+	b.Stops = stops;
+	b.NumStops = 3;
+	for (i = 0; i < stressGradients; i++) {
+		x = (i * 37) % (benchDrawWidth - 32);
+		y = (i * 59) % (benchDrawHeight - 32);
+		// alternate between the two kinds, since they're separate code paths everywhere
+		if (i % 2 == 0) {
+			b.Type = uiDrawBrushTypeLinearGradient;
+			b.X0 = x;
+			b.Y0 = y;
+			b.X1 = x + 32;
+			b.Y1 = y + 32;
+		} else {
+			b.Type = uiDrawBrushTypeRadialGradient;
+			b.X0 = x + 16;
+			b.Y0 = y + 16;
+			b.X1 = x + 16;
+			b.Y1 = y + 16;
+			b.OuterRadius = 16;
+		}
+		path = uiDrawNewPath(uiDrawFillModeWinding);
+		uiDrawPathAddRectangle(path, x, y, 32, 32);
+		uiDrawPathEnd(path);
+		uiDrawFill(p->Context, path, &b);
+		uiDrawFreePath(path);
+	}
+}
+
+static void drawText(uiAreaDrawParams *p, void *data)
+{
+	uiDrawTextLayout *tl = (uiDrawTextLayout *) data;
+
+	uiDrawText(p->Context, tl, 0, 0);
+}
+
+static void layoutText(uiAreaDrawParams *p, void *data)
+{
+	uiDrawTextLayoutParams *tp = (uiDrawTextLayoutParams *) data;
+
+	uiDrawFreeTextLayout(uiDrawNewTextLayout(tp));
+}
+
+static void benchStress(void)
+{
+	uiDrawPath *path;
+	uiAttributedString *s;
+	uiFontDescriptor font;
+	uiDrawTextLayoutParams p;
+	uiDrawTextLayout *tl;
+	int i;
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathNewFigure(path, 0, 0);
+	for (i = 1; i <= stressSegments; i++)
+		uiDrawPathLineTo(path,
+			((double) i) * benchDrawWidth / stressSegments,
+			(i % 2) * benchDrawHeight);
+	uiDrawPathEnd(path);
+	benchRunDraw("stress/stroke-1M-segments", 5, strokeSegments, path);
+	uiDrawFreePath(path);
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	for (i = 0; i < stressRects; i++)
+		uiDrawPathAddRectangle(path,
+			(i % 400) * 1.6, (i / 400) * 1.9,
+			1.5, 1.5);
+	uiDrawPathEnd(path);
+	benchRunDraw("stress/fill-100k-rects", 10, fillRects, path);
+	uiDrawFreePath(path);
+
+	benchRunDraw("stress/gradients-10k", 5, fillGradients, NULL);
+
+	s = uiNewAttributedString("");
+	for (i = 0; i < stressTextRepeats; i++)
+		uiAttributedStringAppendUnattributed(s, "The quick brown fox jumps over the lazy dog. ");
+	memset(&font, 0, sizeof (uiFontDescriptor));
+	font.Family = "sans-serif";
+	font.Size = 9;
+	font.Weight = uiTextWeightNormal;
+	font.Italic = uiTextItalicNormal;
+	font.Stretch = uiTextStretchNormal;
+	p.String = s;
+	p.DefaultFont = &font;
+	p.Width = benchDrawWidth;
+	p.Align = uiDrawTextAlignLeft;
+	benchRunDraw("stress/text-layout-dense", 10, layoutText, &p);
+	tl = uiDrawNewTextLayout(&p);
+	benchRunDraw("stress/text-draw-dense", 20, drawText, tl);
+	uiDrawFreeTextLayout(tl);
+	uiFreeAttributedString(s);
+}
+
+void benchDrawTests(void)
+{
+	char name[256];
+	int n;
+
+	for (n = 0; drawTestName(n) != NULL; n++) {
+		snprintf(name, 256, "drawtests/%s", drawTestName(n));
+		benchRunDraw(name, drawTestIterations, runTest, &n);
+	}
+	benchStress();
+}
@@ -0,0 +1,42 @@
+// 18 october 2026
+#include "bench.h"
+
+// lots of short strokes with the same style, like the ticks on a chart's axes or the segments of a wireframe
+
+#define nStrokes 100000
+
+static uiDrawPath *tick;
+
+static void strokeTicks(uiAreaDrawParams *p, void *data)
+{
+	uiDrawBrush b;
+	uiDrawStrokeParams sp;
+	double dashes[] = { 2, 1 };
+	uiDrawStats before, after;
+	int i;
+
+	benchSetSolidBrush(&b, 0, 0, 0, 1);
+	benchSetStrokeParams(&sp, 1);
+	sp.Dashes = dashes;
+	sp.NumDashes = 2;
+	// the counters are cumulative over every run, since they share a uiDrawContext, so only report this run's share
+	uiDrawContextStats(p->Context, &before);
+	for (i = 0; i < nStrokes; i++)
+		uiDrawStroke(p->Context, tick, &b, &sp);
+	uiDrawContextStats(p->Context, &after);
+	benchSetCounter("skipped_state_changes", (double) (after.SkippedStateChanges - before.SkippedStateChanges));
+}
+
+void benchState(void)
+{
+	tick = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathNewFigure(tick, 10, 10);
+	uiDrawPathLineTo(tick, 10, 16);
+	uiDrawPathEnd(tick);
+	benchRunDraw("state/same-style-strokes-100k", 5, strokeTicks, NULL);
+}
+
+void benchFreeState(void)
+{
+	uiDrawFreePath(tick);
+}
@@ -1970,6 +1970,12 @@ void runDrawTest(int n, uiAreaDrawParams *p)
 	(*(tests[n].draw))(p);
 }
 
+// this returns NULL past the last test
+const char *drawTestName(int n)
+{
+	return tests[n].name;
+}
+
 void populateComboboxWithTests(uiCombobox *c)
 {
 	size_t i;
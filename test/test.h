@@ -52,6 +52,7 @@ extern uiBox *makePage6(void);
 
 // drawtests.c
 extern void runDrawTest(int, uiAreaDrawParams *);
+extern const char *drawTestName(int);
 extern void populateComboboxWithTests(uiCombobox *);
 
 // page7.c
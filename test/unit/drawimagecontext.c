@@ -0,0 +1,203 @@
+#include "unit.h"
+
+#define WIDTH 16
+#define HEIGHT 8
+
+static uint32_t pixelAt(uiDrawImageContext *ic, int x, int y)
+{
+	const uint8_t *pixels;
+	int width, height, stride;
+
+	pixels = uiDrawImageContextPixels(ic, &width, &height, &stride);
+	assert_in_range(x, 0, width - 1);
+	assert_in_range(y, 0, height - 1);
+	return *((const uint32_t *) (pixels + y * stride + x * 4));
+}
+
+static void fillRect(uiDrawImageContext *ic, double x, double y, double width, double height)
+{
+	uiDrawPath *path;
+	uiDrawBrush b = {0};
+
+	b.Type = uiDrawBrushTypeSolid;
+	b.R = 1.0;
+	b.A = 1.0;
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathAddRectangle(path, x, y, width, height);
+	uiDrawPathEnd(path);
+	uiDrawFill(uiDrawImageContextContext(ic), path, &b);
+	uiDrawFreePath(path);
+}
+
+static void drawImageContextSize(void **state)
+{
+	uiDrawImageContext *ic;
+	const uint8_t *pixels;
+	int width, height, stride;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 2);
+	pixels = uiDrawImageContextPixels(ic, &width, &height, &stride);
+	assert_non_null(pixels);
+	assert_int_equal(width, WIDTH * 2);
+	assert_int_equal(height, HEIGHT * 2);
+	assert_true(stride >= width * 4);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextStartsTransparent(void **state)
+{
+	uiDrawImageContext *ic;
+	int x, y;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	for (y = 0; y < HEIGHT; y++)
+		for (x = 0; x < WIDTH; x++)
+			assert_int_equal(pixelAt(ic, x, y), 0);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextFill(void **state)
+{
+	uiDrawImageContext *ic;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	// only the top half, to make sure the image isn't upside down
+	fillRect(ic, 0, 0, WIDTH, HEIGHT / 2);
+	assert_int_equal(pixelAt(ic, 0, 0), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, HEIGHT / 2 - 1), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, 0, HEIGHT / 2), 0);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, HEIGHT - 1), 0);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextFillScaled(void **state)
+{
+	uiDrawImageContext *ic;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 2);
+	fillRect(ic, 0, 0, 1, 1);
+	assert_int_equal(pixelAt(ic, 1, 1), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, 2, 2), 0);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextClear(void **state)
+{
+	uiDrawImageContext *ic;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	fillRect(ic, 0, 0, WIDTH, HEIGHT);
+	assert_int_equal(pixelAt(ic, 0, 0), 0xFFFF0000);
+	uiDrawImageContextClear(ic);
+	assert_int_equal(pixelAt(ic, 0, 0), 0);
+	// and we can keep drawing afterward
+	fillRect(ic, 0, 0, WIDTH, HEIGHT);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, HEIGHT - 1), 0xFFFF0000);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextImageNearest(void **state)
+{
+	uiDrawImageContext *ic;
+	uiImage *i;
+	// RGBA, not premultiplied, as uiImageAppend() wants
+	uint8_t pixels[2 * 2 * 4] = {
+		255, 0, 0, 255,		0, 0, 255, 255,
+		0, 0, 255, 255,		255, 0, 0, 255,
+	};
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	i = uiNewImage(2, 2);
+	uiImageAppend(i, pixels, 2, 2, 2 * 4);
+	uiDrawImage(uiDrawImageContextContext(ic), i, 0, 0, 8, 8, uiDrawImageFilterNearest);
+	// each source pixel becomes a 4x4 block with no blending at the seams
+	assert_int_equal(pixelAt(ic, 0, 0), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, 3, 3), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, 4, 3), 0xFF0000FF);
+	assert_int_equal(pixelAt(ic, 3, 4), 0xFF0000FF);
+	assert_int_equal(pixelAt(ic, 7, 7), 0xFFFF0000);
+	// and nothing outside the destination rectangle is touched
+	assert_int_equal(pixelAt(ic, 8, 0), 0);
+	// drawing again uses the cached copy and gets the same result
+	uiDrawImage(uiDrawImageContextContext(ic), i, 0, 0, 8, 8, uiDrawImageFilterNearest);
+	assert_int_equal(pixelAt(ic, 4, 3), 0xFF0000FF);
+	uiFreeImage(i);
+	uiDrawFreeImageContext(ic);
+}
+
+static void drawImageContextCulling(void **state)
+{
+	uiDrawImageContext *ic;
+	uiDrawContext *c;
+	uiDrawPath *path;
+	uiDrawBrush b = {0};
+	uiDrawStrokeParams sp = {0};
+	uiDrawStats stats;
+	uiDrawMatrix m;
+
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	c = uiDrawImageContextContext(ic);
+	b.Type = uiDrawBrushTypeSolid;
+	b.R = 1.0;
+	b.A = 1.0;
+	sp.Cap = uiDrawLineCapFlat;
+	sp.Join = uiDrawLineJoinMiter;
+	sp.Thickness = 4;
+	sp.MiterLimit = uiDrawDefaultMiterLimit;
+	// just past the right edge
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathAddRectangle(path, WIDTH + 1, 0, 4, 4);
+	uiDrawPathEnd(path);
+
+	uiDrawFill(c, path, &b);
+	uiDrawContextStats(c, &stats);
+	assert_int_equal(stats.CulledOperations, 1);
+	// but a thick enough stroke reaches back inside, so it must be drawn
+	uiDrawStroke(c, path, &b, &sp);
+	uiDrawContextStats(c, &stats);
+	assert_int_equal(stats.CulledOperations, 1);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, 1), 0xFFFF0000);
+	// and moving the path into view with a transform means it isn't culled either
+	uiDrawMatrixSetIdentity(&m);
+	uiDrawMatrixTranslate(&m, -WIDTH, 0);
+	uiDrawTransform(c, &m);
+	uiDrawFill(c, path, &b);
+	uiDrawContextStats(c, &stats);
+	assert_int_equal(stats.CulledOperations, 1);
+	assert_int_equal(pixelAt(ic, 2, 2), 0xFFFF0000);
+
+	uiDrawFreePath(path);
+	uiDrawFreeImageContext(ic);
+}
+
+static int drawImageContextTestSetup(void **state)
+{
+	uiInitOptions o = {0};
+
+	assert_null(uiInit(&o));
+	return 0;
+}
+
+static int drawImageContextTestTeardown(void **state)
+{
+	uiUninit();
+	return 0;
+}
+
+#define drawImageContextUnitTest(f) cmocka_unit_test_setup_teardown((f), \
+		drawImageContextTestSetup, drawImageContextTestTeardown)
+
+int drawImageContextRunUnitTests(void)
+{
+	const struct CMUnitTest tests[] = {
+		drawImageContextUnitTest(drawImageContextSize),
+		drawImageContextUnitTest(drawImageContextStartsTransparent),
+		drawImageContextUnitTest(drawImageContextFill),
+		drawImageContextUnitTest(drawImageContextFillScaled),
+		drawImageContextUnitTest(drawImageContextClear),
+		drawImageContextUnitTest(drawImageContextImageNearest),
+		drawImageContextUnitTest(drawImageContextCulling),
+	};
+
+	return cmocka_run_group_tests_name("uiDrawImageContext", tests, NULL, NULL);
+}
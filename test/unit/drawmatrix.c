@@ -174,6 +174,35 @@ static void drawMatrixMultiply(void **state)
 	assertMatrixEqual(&expected, m);
 }
 
+static void drawMatrixTransformPoints(void **state)
+{
+	uiDrawMatrix *m = *state;
+	// an odd number, so the SIMD paths have leftovers to handle
+	double xy[2 * 7];
+	float xyf[2 * 7];
+	double x, y;
+	size_t i;
+
+	uiDrawMatrixTranslate(m, 0.5, 0.25);
+	uiDrawMatrixRotate(m, 0.5, 0.25, THETA);
+	uiDrawMatrixScale(m, 0.5, 0.25, 0.3, 0.1);
+	for (i = 0; i < 2 * 7; i++) {
+		xy[i] = i * 1.5 - 4;
+		xyf[i] = (float) (xy[i]);
+	}
+	uiDrawMatrixTransformPoints(m, xy, 7);
+	uiDrawMatrixTransformPointsFloat(m, xyf, 7);
+	for (i = 0; i < 7; i++) {
+		x = (2 * i) * 1.5 - 4;
+		y = (2 * i + 1) * 1.5 - 4;
+		uiDrawMatrixTransformPoint(m, &x, &y);
+		assert_true(expectDoubleEqual(xy[2 * i], x, 1, "x: "));
+		assert_true(expectDoubleEqual(xy[2 * i + 1], y, 1, "y: "));
+		assert_true(compareDouble(xyf[2 * i], x, 0.0001));
+		assert_true(compareDouble(xyf[2 * i + 1], y, 0.0001));
+	}
+}
+
 static int drawMatrixTestsSetup(void **state)
 {
 	*state = malloc(sizeof(uiDrawMatrix));
@@ -211,6 +240,7 @@ int drawMatrixRunUnitTests(void)
 		drawMatrixUnitTest(drawMatrixRotate),
 		drawMatrixUnitTest(drawMatrixTRS),
 		drawMatrixUnitTest(drawMatrixMultiply),
+		drawMatrixUnitTest(drawMatrixTransformPoints),
 	};
 
 	return cmocka_run_group_tests_name("uiDrawMatrix", tests, drawMatrixTestsSetup, drawMatrixTestsTeardown);
@@ -0,0 +1,90 @@
+#include "unit.h"
+
+#define WIDTH 16
+#define HEIGHT 8
+
+static uint32_t pixelAt(uiDrawImageContext *ic, int x, int y)
+{
+	const uint8_t *pixels;
+	int width, height, stride;
+
+	pixels = uiDrawImageContextPixels(ic, &width, &height, &stride);
+	return *((const uint32_t *) (pixels + y * stride + x * 4));
+}
+
+static void fillPixels(uiDrawPixelBuffer *pb, int x0, int y0, int x1, int y1, uint32_t color)
+{
+	uint8_t *pixels;
+	int stride;
+	int x, y;
+
+	pixels = uiDrawPixelBufferBegin(pb, &stride);
+	assert_non_null(pixels);
+	assert_true(stride >= WIDTH * 4);
+	for (y = y0; y < y1; y++)
+		for (x = x0; x < x1; x++)
+			*((uint32_t *) (pixels + y * stride + x * 4)) = color;
+	uiDrawPixelBufferEnd(pb, x0, y0, x1 - x0, y1 - y0);
+}
+
+static void drawPixelBufferDraw(void **state)
+{
+	uiDrawPixelBuffer *pb;
+	uiDrawImageContext *ic;
+
+	pb = uiDrawNewPixelBuffer(WIDTH, HEIGHT);
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	fillPixels(pb, 0, 0, WIDTH / 2, HEIGHT, 0xFFFF0000);
+	uiDrawPixels(uiDrawImageContextContext(ic), pb, 0, 0, WIDTH, HEIGHT);
+	assert_int_equal(pixelAt(ic, 0, 0), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, WIDTH / 2 - 1, HEIGHT - 1), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, 0), 0);
+	uiDrawFreeImageContext(ic);
+	uiDrawFreePixelBuffer(pb);
+}
+
+static void drawPixelBufferUpdate(void **state)
+{
+	uiDrawPixelBuffer *pb;
+	uiDrawImageContext *ic;
+
+	pb = uiDrawNewPixelBuffer(WIDTH, HEIGHT);
+	ic = uiDrawNewImageContext(WIDTH, HEIGHT, 1);
+	fillPixels(pb, 0, 0, WIDTH, HEIGHT, 0xFFFF0000);
+	uiDrawPixels(uiDrawImageContextContext(ic), pb, 0, 0, WIDTH, HEIGHT);
+	// only change part of it; the rest must keep what was written before
+	fillPixels(pb, WIDTH / 2, 0, WIDTH, HEIGHT, 0xFF0000FF);
+	uiDrawImageContextClear(ic);
+	uiDrawPixels(uiDrawImageContextContext(ic), pb, 0, 0, WIDTH, HEIGHT);
+	assert_int_equal(pixelAt(ic, 0, 0), 0xFFFF0000);
+	assert_int_equal(pixelAt(ic, WIDTH - 1, HEIGHT - 1), 0xFF0000FF);
+	uiDrawFreeImageContext(ic);
+	uiDrawFreePixelBuffer(pb);
+}
+
+static int drawPixelBufferTestSetup(void **state)
+{
+	uiInitOptions o = {0};
+
+	assert_null(uiInit(&o));
+	return 0;
+}
+
+static int drawPixelBufferTestTeardown(void **state)
+{
+	uiUninit();
+	return 0;
+}
+
+#define drawPixelBufferUnitTest(f) cmocka_unit_test_setup_teardown((f), \
+		drawPixelBufferTestSetup, drawPixelBufferTestTeardown)
+
+int drawPixelBufferRunUnitTests(void)
+{
+	const struct CMUnitTest tests[] = {
+		drawPixelBufferUnitTest(drawPixelBufferDraw),
+		drawPixelBufferUnitTest(drawPixelBufferUpdate),
+	};
+
+	return cmocka_run_group_tests_name("uiDrawPixelBuffer", tests, NULL, NULL);
+}
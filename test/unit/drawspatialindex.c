@@ -0,0 +1,164 @@
+#include "unit.h"
+
+// a grid of 100x100 squares, each 10 wide with a gap of 5 between them
+#define N 100
+#define SIZE 10
+#define PITCH 15
+
+static uiDrawSpatialIndex *newGrid(void)
+{
+	uiDrawSpatialIndex *si;
+	size_t i;
+
+	si = uiDrawNewSpatialIndex();
+	for (i = 0; i < N * N; i++)
+		uiDrawSpatialIndexAdd(si, (i % N) * PITCH, (i / N) * PITCH, SIZE, SIZE, (void *) (i + 1));
+	return si;
+}
+
+struct hits {
+	size_t n;
+	void *last;
+};
+
+static uiForEach countHits(uiDrawSpatialIndex *si, void *data, void *senderData)
+{
+	struct hits *h = (struct hits *) senderData;
+
+	h->n++;
+	h->last = data;
+	return uiForEachContinue;
+}
+
+static uiForEach stopAtFirst(uiDrawSpatialIndex *si, void *data, void *senderData)
+{
+	countHits(si, data, senderData);
+	return uiForEachStop;
+}
+
+static void drawSpatialIndexPoint(void **state)
+{
+	uiDrawSpatialIndex *si;
+	struct hits h = {0};
+
+	si = newGrid();
+	assert_int_equal(uiDrawSpatialIndexCount(si), N * N);
+	// the square in row 3, column 7
+	uiDrawSpatialIndexQuery(si, 7 * PITCH + 1, 3 * PITCH + 1, 0, 0, countHits, &h);
+	assert_int_equal(h.n, 1);
+	assert_true(h.last == (void *) (3 * N + 7 + 1));
+	// and the gap next to it
+	h.n = 0;
+	uiDrawSpatialIndexQuery(si, 7 * PITCH + SIZE + 1, 3 * PITCH + 1, 0, 0, countHits, &h);
+	assert_int_equal(h.n, 0);
+	uiDrawFreeSpatialIndex(si);
+}
+
+static void drawSpatialIndexRect(void **state)
+{
+	uiDrawSpatialIndex *si;
+	struct hits h = {0};
+
+	si = newGrid();
+	// this covers a 4x3 block of squares, and just touches the edge of the next row
+	uiDrawSpatialIndexQuery(si, 2 * PITCH, 5 * PITCH, 3 * PITCH + SIZE - 1, 3 * PITCH, countHits, &h);
+	assert_int_equal(h.n, 4 * 4);
+	h.n = 0;
+	uiDrawSpatialIndexQuery(si, 0, 0, N * PITCH, N * PITCH, stopAtFirst, &h);
+	assert_int_equal(h.n, 1);
+	uiDrawFreeSpatialIndex(si);
+}
+
+static void drawSpatialIndexRemove(void **state)
+{
+	uiDrawSpatialIndex *si;
+	struct hits h = {0};
+
+	si = newGrid();
+	uiDrawSpatialIndexQuery(si, 1, 1, 0, 0, countHits, &h);
+	assert_int_equal(h.n, 1);
+	uiDrawSpatialIndexRemove(si, (void *) 1);
+	assert_int_equal(uiDrawSpatialIndexCount(si), N * N - 1);
+	h.n = 0;
+	uiDrawSpatialIndexQuery(si, 1, 1, 0, 0, countHits, &h);
+	assert_int_equal(h.n, 0);
+	// adding after a query works too
+	uiDrawSpatialIndexAdd(si, 0, 0, 2, 2, (void *) 1);
+	uiDrawSpatialIndexQuery(si, 1, 1, 0, 0, countHits, &h);
+	assert_int_equal(h.n, 1);
+	uiDrawFreeSpatialIndex(si);
+}
+
+static void drawSpatialIndexEmpty(void **state)
+{
+	uiDrawSpatialIndex *si;
+	struct hits h = {0};
+
+	si = uiDrawNewSpatialIndex();
+	uiDrawSpatialIndexQuery(si, 0, 0, 100, 100, countHits, &h);
+	assert_int_equal(h.n, 0);
+	uiDrawFreeSpatialIndex(si);
+}
+
+static void drawPathHitTest(void **state)
+{
+	uiDrawPath *path;
+	uiDrawStrokeParams sp = {0};
+	double x, y, width, height;
+
+	path = uiDrawNewPath(uiDrawFillModeAlternate);
+	uiDrawPathAddRectangle(path, 10, 10, 80, 80);
+	uiDrawPathAddRectangle(path, 30, 30, 40, 40);
+	uiDrawPathEnd(path);
+
+	assert_true(uiDrawPathBounds(path, &x, &y, &width, &height));
+	assert_true(x == 10 && y == 10 && width == 80 && height == 80);
+
+	assert_true(uiDrawPathContainsPoint(path, 20, 20));
+	// the alternate fill mode leaves a hole in the middle
+	assert_false(uiDrawPathContainsPoint(path, 50, 50));
+	assert_false(uiDrawPathContainsPoint(path, 5, 5));
+
+	sp.Cap = uiDrawLineCapFlat;
+	sp.Join = uiDrawLineJoinMiter;
+	sp.Thickness = 4;
+	sp.MiterLimit = uiDrawDefaultMiterLimit;
+	assert_true(uiDrawPathStrokeContainsPoint(path, 9, 50, &sp));
+	assert_false(uiDrawPathStrokeContainsPoint(path, 20, 50, &sp));
+	uiDrawFreePath(path);
+
+	path = uiDrawNewPath(uiDrawFillModeWinding);
+	uiDrawPathEnd(path);
+	assert_false(uiDrawPathBounds(path, &x, &y, &width, &height));
+	uiDrawFreePath(path);
+}
+
+static int drawSpatialIndexTestSetup(void **state)
+{
+	uiInitOptions o = {0};
+
+	assert_null(uiInit(&o));
+	return 0;
+}
+
+static int drawSpatialIndexTestTeardown(void **state)
+{
+	uiUninit();
+	return 0;
+}
+
+#define drawSpatialIndexUnitTest(f) cmocka_unit_test_setup_teardown((f), \
+		drawSpatialIndexTestSetup, drawSpatialIndexTestTeardown)
+
+int drawSpatialIndexRunUnitTests(void)
+{
+	const struct CMUnitTest tests[] = {
+		drawSpatialIndexUnitTest(drawSpatialIndexPoint),
+		drawSpatialIndexUnitTest(drawSpatialIndexRect),
+		drawSpatialIndexUnitTest(drawSpatialIndexRemove),
+		drawSpatialIndexUnitTest(drawSpatialIndexEmpty),
+		drawSpatialIndexUnitTest(drawPathHitTest),
+	};
+
+	return cmocka_run_group_tests_name("uiDrawSpatialIndex", tests, NULL, NULL);
+}
@@ -19,11 +19,22 @@ static void initUninitTwice(void **state)
 	uiUninit();
 }
 
+static void initUninitWarmUpFonts(void **state)
+{
+	uiInitOptions o = {0};
+
+	o.Size = sizeof (uiInitOptions);
+	o.Flags = uiInitFlagWarmUpFonts;
+	assert_null(uiInit(&o));
+	uiUninit();
+}
+
 int initRunUnitTests(void)
 {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(initUninit),
 		cmocka_unit_test(initUninitTwice),
+		cmocka_unit_test(initUninitWarmUpFonts),
 	};
 
 	return cmocka_run_group_tests_name("uiInit", tests, NULL, NULL);
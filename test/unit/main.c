@@ -68,6 +68,9 @@ int main(void)
 		{ entryRunUnitTests },
 		{ progressBarRunUnitTests },
 		{ drawMatrixRunUnitTests },
+		{ drawImageContextRunUnitTests },
+		{ drawPixelBufferRunUnitTests },
+		{ drawSpatialIndexRunUnitTests },
 	};
 
 	for (i = 0; i < sizeof(unitTests)/sizeof(*unitTests); ++i) {
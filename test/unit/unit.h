@@ -25,6 +25,9 @@ int entryRunUnitTests(void);
 int menuRunUnitTests(void);
 int progressBarRunUnitTests(void);
 int drawMatrixRunUnitTests(void);
+int drawImageContextRunUnitTests(void);
+int drawPixelBufferRunUnitTests(void);
+int drawSpatialIndexRunUnitTests(void);
 
 /**
  * Helper for general setup/teardown of controls embedded in a window.
@@ -57,8 +57,23 @@ _UI_ENUM(uiForEach) {
 
 typedef struct uiInitOptions uiInitOptions;
 
+// uiInitFlags are optional behaviors that can be requested from
+// uiInit() through uiInitOptions.Flags. Flags is only read if
+// uiInitOptions.Size is set to sizeof (uiInitOptions), so programs
+// built against older versions of ui.h keep working.
+_UI_ENUM(uiInitFlags) {
+	// uiInitFlagWarmUpFonts starts loading the system's font
+	// configuration and commonly used fonts in the background
+	// during uiInit(), so the first text drawn does not have to wait
+	// for it. The last step runs on the main thread once the main loop
+	// is running. Use uiFontWarmUpStats() to see how long that took.
+	// This currently only has an effect on Unix.
+	uiInitFlagWarmUpFonts = 1 << 0,
+};
+
 struct uiInitOptions {
 	size_t Size;
+	uiInitFlags Flags;
 };
 
 _UI_EXTERN const char *uiInit(uiInitOptions *options);
@@ -2039,9 +2054,94 @@ _UI_ENUM(uiWindowResizeEdge) {
 // TODO give a better name
 // TODO document the types of width and height
 _UI_EXTERN void uiAreaSetSize(uiArea *a, int width, int height);
-// TODO uiAreaQueueRedraw()
 _UI_EXTERN void uiAreaQueueRedrawAll(uiArea *a);
+// uiAreaQueueRedrawRect() queues a redraw of only the given
+// rectangle of a, in the same coordinates as drawing. Use this instead
+// of uiAreaQueueRedrawAll() when only a small part of a changed, such
+// as a blinking cursor. All the rectangles queued before the next
+// redraw are redrawn together, and the Clip fields of
+// uiAreaDrawParams tell your Draw handler which part needs redrawing.
+_UI_EXTERN void uiAreaQueueRedrawRect(uiArea *a, double x, double y, double width, double height);
+// uiAreaQueueRedrawRects() is like calling uiAreaQueueRedrawRect()
+// for each of the n rectangles in rects, which holds the x, y, width,
+// and height of each rectangle one after the other.
+// If the rectangles are far apart, your Draw handler may be called
+// once for each of them instead of once for everything between them.
+_UI_EXTERN void uiAreaQueueRedrawRects(uiArea *a, const double *rects, size_t n);
+// uiAreaScrollTo() scrolls a scrolling uiArea as little as possible
+// to make the given rectangle visible. If the rectangle is bigger
+// than the visible part of a, its top-left corner is made visible.
 _UI_EXTERN void uiAreaScrollTo(uiArea *a, double x, double y, double width, double height);
+// uiAreaSetBackingStore() turns the backing store of a scrolling
+// uiArea on or off. With the backing store on, a keeps what it has
+// drawn of the visible part of itself, plus margin units on each
+// side, in an offscreen image, and when it scrolls your Draw handler
+// is only called for the parts that weren't in that image already.
+// uiAreaQueueRedrawAll() and friends throw away the affected parts of
+// the image, so call them whenever your content changes, as usual.
+// This is off by default. On systems that already keep scrolled
+// content around on their own, this does nothing.
+_UI_EXTERN void uiAreaSetBackingStore(uiArea *a, int enabled, double margin);
+
+// uiAreaResizePolicy says what a non-scrolling uiArea redraws when
+// its size changes.
+// uiAreaResizeRedrawAll, the default, redraws everything.
+// uiAreaResizeRedrawExposed only redraws the parts that weren't
+// visible before; use it if nothing you draw depends on the size of
+// the area.
+// uiAreaResizeDeferred stretches what was last drawn to fit the new
+// size, and only redraws everything once the size has stopped
+// changing for a moment. Use it if your Draw handler is too slow to
+// keep up with the user resizing the window.
+_UI_ENUM(uiAreaResizePolicy) {
+	uiAreaResizeRedrawAll,
+	uiAreaResizeRedrawExposed,
+	uiAreaResizeDeferred,
+};
+
+// uiAreaSetResizePolicy() sets the resize policy of a non-scrolling
+// uiArea. Some systems always redraw everything after a resize; on
+// those, the policy is ignored. It is currently only implemented on
+// Unix.
+_UI_EXTERN void uiAreaSetResizePolicy(uiArea *a, uiAreaResizePolicy policy);
+// uiAreaScaleFactor() returns the number of device pixels per unit
+// of drawing space in a, for sizing uiDrawCachedLayers. This is 1
+// except on HiDPI screens.
+_UI_EXTERN double uiAreaScaleFactor(uiArea *a);
+// uiAreaAnimationFunc is the type of the function passed to
+// uiAreaSetAnimationCallback(). frameTime is the time the current
+// frame started and presentationTime is the time the frame is
+// expected to reach the screen, both in seconds on a monotonic clock
+// with an arbitrary starting point. Advance your animation to
+// presentationTime, then queue a redraw of whatever changed.
+// Return nonzero to be called again for the next frame, or 0 to stop.
+typedef int (*uiAreaAnimationFunc)(uiArea *a, double frameTime, double presentationTime, void *data);
+// uiAreaSetAnimationCallback() arranges for f to be called once
+// per frame, in step with the display where the OS allows it, until
+// f returns 0. Calling this again replaces the previous callback;
+// passing NULL for f stops the animation.
+_UI_EXTERN void uiAreaSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data);
+// uiAreaSetTiledRendering() makes a split each redraw into square
+// tiles tileSize units on a side and draw them in parallel on threads
+// worker threads, or one per processor if threads is 0. Your Draw
+// handler is called once per tile, with the Clip fields set to the
+// tile and a uiDrawContext of its own; draw everything that touches
+// the clip rectangle, as usual. The results are put together on the
+// screen once all the tiles are done. Pass a tileSize of 0 to go back
+// to drawing everything at once on the main thread.
+//
+// While tiled rendering is on, your Draw handler is called on other
+// threads and several times at once, so it must be thread-safe: it
+// may make and free uiDrawPaths, call the uiDraw* functions that take
+// a uiDrawContext, and read your own data, but it must not call any
+// other libui functions or change anything shared between tiles.
+// Brushes, text layouts, and anything else it needs should be made
+// beforehand on the main thread. The main thread waits for all the tiles to finish,
+// so your data won't change under you in the meantime.
+//
+// Tiled rendering is currently only implemented on Unix; on other
+// systems this does nothing.
+_UI_EXTERN void uiAreaSetTiledRendering(uiArea *a, int tileSize, int threads);
 // TODO document these can only be called within Mouse() handlers
 // TODO should these be allowed on scrolling areas?
 // TODO decide which mouse events should be accepted; Down is the only one guaranteed to work right now
@@ -2175,13 +2275,80 @@ _UI_EXTERN void uiDrawPathCloseFigure(uiDrawPath *p);
 
 // TODO effect of these when a figure is already started
 _UI_EXTERN void uiDrawPathAddRectangle(uiDrawPath *p, double x, double y, double width, double height);
+// uiDrawPathAddPolyline() starts a new figure at the first of the n
+// points in xy and adds lines to each of the rest, as if by calling
+// uiDrawPathNewFigure() and then uiDrawPathLineTo() for each. xy holds
+// the x and y coordinates of each point one after the other, so it has
+// 2 * n elements. This is much faster than making each call yourself.
+_UI_EXTERN void uiDrawPathAddPolyline(uiDrawPath *p, const double *xy, size_t n);
+
+// uiDrawPathAddDecimatedSeries() is for plotting series with far more
+// samples than there are pixels to show them in. It maps each sample
+// (xs[i], ys[i]) through m (or leaves it alone if m is NULL), splits the
+// results into columns pixelTolerance units wide along x, and adds a
+// polyline through only the first, last, lowest, and highest sample of
+// each column. At a pixelTolerance of one device pixel, the stroked
+// result looks the same as a polyline through every sample, but has at
+// most four points per column no matter how many samples there are.
+// Samples that are NaN or infinite leave a gap: the polyline stops
+// there and a new figure starts at the next sample.
+_UI_EXTERN void uiDrawPathAddDecimatedSeries(uiDrawPath *p, const double *xs, const double *ys, size_t n, uiDrawMatrix *m, double pixelTolerance);
 
 _UI_EXTERN int uiDrawPathEnded(uiDrawPath *p);
 _UI_EXTERN void uiDrawPathEnd(uiDrawPath *p);
+// uiDrawPathReset() removes everything from p and un-ends it, so it
+// can be built again with the same fill mode. This reuses the memory
+// p already has, so it's cheaper than freeing p and making a new
+// uiDrawPath for every frame.
+_UI_EXTERN void uiDrawPathReset(uiDrawPath *p);
+
+// uiDrawPathBounds() stores the rectangle that encloses everything in
+// p, which must be ended. It returns 0 (and leaves the outputs alone)
+// if p is empty. The rectangle may include the control points of
+// Bezier curves, so it can be a little larger than the path itself.
+// It does not include the width of any stroke.
+_UI_EXTERN int uiDrawPathBounds(uiDrawPath *p, double *x, double *y, double *width, double *height);
+
+// uiDrawPathContainsPoint() returns nonzero if filling p (which must
+// be ended) would paint the point (x, y), using the fill mode p was
+// made with. uiDrawPathStrokeContainsPoint() does the same for
+// stroking p with sp. Both work in the coordinates p was built in;
+// they are meant for finding what's under the mouse in a uiArea
+// without drawing anything.
+_UI_EXTERN int uiDrawPathContainsPoint(uiDrawPath *p, double x, double y);
+_UI_EXTERN int uiDrawPathStrokeContainsPoint(uiDrawPath *p, double x, double y, uiDrawStrokeParams *sp);
 
 _UI_EXTERN void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p);
 _UI_EXTERN void uiDrawFill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b);
 
+// uiDrawCachedBrush is a uiDrawBrush that has been converted to the
+// OS's native representation once, so that it can be used for many
+// strokes and fills without being converted every time. Use these for
+// gradients and other brushes you draw with over and over.
+typedef struct uiDrawCachedBrush uiDrawCachedBrush;
+
+// uiDrawNewBrush() makes a uiDrawCachedBrush out of b. b (including
+// its gradient stops) is copied, so you can free or change it
+// afterward without affecting the returned uiDrawCachedBrush.
+_UI_EXTERN uiDrawCachedBrush *uiDrawNewBrush(const uiDrawBrush *b);
+_UI_EXTERN void uiDrawFreeBrush(uiDrawCachedBrush *b);
+_UI_EXTERN void uiDrawStrokeCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b, uiDrawStrokeParams *p);
+_UI_EXTERN void uiDrawFillCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b);
+
+// uiDrawFillRects() fills n rectangles with b. rects holds the x, y,
+// width, and height of each rectangle one after the other, so it has
+// 4 * n elements. This is the same as filling a uiDrawPath made of
+// the rectangles with uiDrawFillModeWinding, but without having to
+// build that path.
+_UI_EXTERN void uiDrawFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b);
+// uiDrawFillRectsColored() is like uiDrawFillRects(), but fills each
+// rectangle with its own solid color. colors holds the red, green,
+// blue, and alpha of each rectangle one after the other, so it has
+// 4 * n elements.
+// Consecutive rectangles with the same color are drawn together, so
+// group rectangles by color where you can.
+_UI_EXTERN void uiDrawFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n);
+
 // TODO primitives:
 // - rounded rectangles
 // - elliptical arcs
@@ -2197,6 +2364,16 @@ _UI_EXTERN int uiDrawMatrixInvertible(uiDrawMatrix *m);
 _UI_EXTERN int uiDrawMatrixInvert(uiDrawMatrix *m);
 _UI_EXTERN void uiDrawMatrixTransformPoint(uiDrawMatrix *m, double *x, double *y);
 _UI_EXTERN void uiDrawMatrixTransformSize(uiDrawMatrix *m, double *x, double *y);
+// uiDrawMatrixTransformPoints() transforms n points in place, as if by
+// calling uiDrawMatrixTransformPoint() on each. xy holds the x and y
+// coordinates of each point one after the other, so it has 2 * n
+// elements. This uses SIMD instructions where available, so it is much
+// faster than transforming each point yourself.
+// uiDrawMatrixTransformPointsFloat() is the same for points stored as
+// floats, which halves the memory traffic for large datasets at the
+// cost of precision.
+_UI_EXTERN void uiDrawMatrixTransformPoints(uiDrawMatrix *m, double *xy, size_t n);
+_UI_EXTERN void uiDrawMatrixTransformPointsFloat(uiDrawMatrix *m, float *xy, size_t n);
 
 _UI_EXTERN void uiDrawTransform(uiDrawContext *c, uiDrawMatrix *m);
 
@@ -2206,6 +2383,136 @@ _UI_EXTERN void uiDrawClip(uiDrawContext *c, uiDrawPath *path);
 _UI_EXTERN void uiDrawSave(uiDrawContext *c);
 _UI_EXTERN void uiDrawRestore(uiDrawContext *c);
 
+// uiDrawStats holds counters about the work a uiDrawContext did (or
+// didn't do) so far. These are meant for profiling your drawing code;
+// they are not guaranteed to be the same across platforms, and
+// platforms that don't keep a particular counter leave it at 0.
+typedef struct uiDrawStats uiDrawStats;
+
+struct uiDrawStats {
+	// SkippedStateChanges is the number of times a uiDrawStroke(),
+	// uiDrawFill(), or similar call didn't have to change a piece of
+	// drawing state (line width, fill rule, and so on) because it was
+	// already set to the right value.
+	size_t SkippedStateChanges;
+
+	// CulledOperations is the number of times a uiDrawStroke() or
+	// uiDrawFill() call (or the cached brush versions) drew nothing
+	// because the bounds of the path, widened by the stroke, lay
+	// entirely outside the current clip. Zoomed-in views of large
+	// scenes should see most of their operations culled.
+	size_t CulledOperations;
+};
+
+// uiDrawContextStats() fills s with the counters for c so far. Since a
+// uiDrawContext only lives for one call to your Draw handler, this
+// covers only that call.
+_UI_EXTERN void uiDrawContextStats(uiDrawContext *c, uiDrawStats *s);
+
+// uiDrawCachedLayer is an offscreen image that you can draw into once
+// with the ordinary drawing functions and then draw into a
+// uiDrawContext as many times as you want. Use one for expensive
+// parts of a uiArea that rarely change, such as a grid or a map
+// underneath a moving overlay.
+//
+// A uiDrawCachedLayer has a size in the same units as a uiArea and a
+// scale, which is the number of pixels per unit; pass the value of
+// uiAreaScaleFactor() so the layer looks as sharp as everything
+// else on HiDPI screens.
+typedef struct uiDrawCachedLayer uiDrawCachedLayer;
+
+_UI_EXTERN uiDrawCachedLayer *uiDrawNewLayer(double width, double height, double scale);
+_UI_EXTERN void uiDrawFreeLayer(uiDrawCachedLayer *l);
+
+// uiDrawLayerBegin() clears l and returns a uiDrawContext that draws
+// into it, with (0, 0) at the top-left corner of l. Call
+// uiDrawLayerEnd() when you're done drawing; the uiDrawContext is
+// freed then. l becomes valid at that point.
+_UI_EXTERN uiDrawContext *uiDrawLayerBegin(uiDrawCachedLayer *l);
+_UI_EXTERN void uiDrawLayerEnd(uiDrawCachedLayer *l);
+
+// A uiDrawCachedLayer is never invalidated on its own; call
+// uiDrawLayerInvalidate() when what's drawn in it is out of date and
+// check uiDrawLayerValid() in your Draw handler to decide whether to
+// redraw it. New layers are not valid.
+_UI_EXTERN void uiDrawLayerInvalidate(uiDrawCachedLayer *l);
+_UI_EXTERN int uiDrawLayerValid(uiDrawCachedLayer *l);
+
+// uiDrawLayer() draws l into c with its top-left corner at (x, y).
+// It is drawn with whatever it last had in it, whether valid or not.
+_UI_EXTERN void uiDrawLayer(uiDrawContext *c, uiDrawCachedLayer *l, double x, double y);
+
+// uiDrawImageContext is an image in memory with a uiDrawContext that
+// draws into it, so you can use the drawing functions without a
+// uiArea, for instance to make thumbnails or to export a drawing to
+// a file. It does not need a window to be open, but uiInit() must
+// still have been called.
+//
+// Like a uiDrawCachedLayer, a uiDrawImageContext has a size in drawing
+// units and a scale, which is the number of pixels per unit; the image
+// is the size times the scale, rounded up, in pixels.
+typedef struct uiDrawImageContext uiDrawImageContext;
+
+// uiDrawNewImageContext() creates a new uiDrawImageContext. The image
+// starts out fully transparent.
+_UI_EXTERN uiDrawImageContext *uiDrawNewImageContext(double width, double height, double scale);
+_UI_EXTERN void uiDrawFreeImageContext(uiDrawImageContext *ic);
+
+// uiDrawImageContextContext() returns the uiDrawContext that draws
+// into ic, with (0, 0) at the top-left corner of the image. It stays
+// valid until ic is freed.
+_UI_EXTERN uiDrawContext *uiDrawImageContextContext(uiDrawImageContext *ic);
+
+// uiDrawImageContextClear() makes everything inside the current clip
+// of ic fully transparent again.
+_UI_EXTERN void uiDrawImageContextClear(uiDrawImageContext *ic);
+
+// uiDrawImageContextPixels() returns the pixels of ic, top row
+// first, after finishing any drawing in progress. Each pixel is a
+// native-endian uint32_t of the form 0xAARRGGBB, with the color
+// components premultiplied by alpha. width and height receive the
+// size of the image in pixels and stride the number of bytes from
+// the start of one row to the start of the next.
+// The pixels must not be modified, and are only valid until the next
+// drawing call on ic or until ic is freed.
+_UI_EXTERN const uint8_t *uiDrawImageContextPixels(uiDrawImageContext *ic, int *width, int *height, int *stride);
+
+// uiDrawImageContextWritePNG() saves ic as a PNG file with the given
+// filename, which is in UTF-8. It returns nonzero on success and
+// zero if the file could not be written.
+_UI_EXTERN int uiDrawImageContextWritePNG(uiDrawImageContext *ic, const char *filename);
+
+// uiDrawPixelBuffer is a block of pixels that you write into directly
+// and then draw into a uiDrawContext, for instance from a software
+// renderer. Unlike a uiImage, it can be changed as often as you like,
+// and only the parts you change are sent to the screen again.
+// The pixels are in the same format as those of
+// uiDrawImageContextPixels(): native-endian uint32_t values of the
+// form 0xAARRGGBB, premultiplied by alpha.
+typedef struct uiDrawPixelBuffer uiDrawPixelBuffer;
+
+// uiDrawNewPixelBuffer() creates a new uiDrawPixelBuffer of the given
+// size in pixels. All of its pixels start out fully transparent.
+_UI_EXTERN uiDrawPixelBuffer *uiDrawNewPixelBuffer(int width, int height);
+_UI_EXTERN void uiDrawFreePixelBuffer(uiDrawPixelBuffer *pb);
+
+// uiDrawPixelBufferBegin() returns the pixels of pb for you to change,
+// top row first; stride receives the number of bytes from the start of
+// one row to the start of the next. The pixels are not copied, so they
+// keep whatever you wrote last time. When you're done, call
+// uiDrawPixelBufferEnd() with the rectangle, in pixels, that you
+// changed; the pointer must not be used after that. Don't call
+// uiDrawPixels() on pb in between.
+_UI_EXTERN uint8_t *uiDrawPixelBufferBegin(uiDrawPixelBuffer *pb, int *stride);
+_UI_EXTERN void uiDrawPixelBufferEnd(uiDrawPixelBuffer *pb, int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight);
+
+// uiDrawPixels() draws pb into c, stretched to fill the given
+// rectangle. To show a uiDrawPixelBuffer in a uiArea, call this from
+// your Draw handler and call uiAreaQueueRedrawRect() with the part
+// of the area the dirty rectangle ends up in after
+// uiDrawPixelBufferEnd().
+_UI_EXTERN void uiDrawPixels(uiDrawContext *c, uiDrawPixelBuffer *pb, double x, double y, double width, double height);
+
 // uiAttribute stores information about an attribute in a
 // uiAttributedString.
 //
@@ -2631,6 +2938,35 @@ struct uiFontDescriptor {
 _UI_EXTERN void uiLoadControlFont(uiFontDescriptor *f);
 _UI_EXTERN void uiFreeFontDescriptor(uiFontDescriptor *desc);
 
+// uiFontMetrics() returns the basic metrics of the font described by
+// desc, in the same units as uiDrawTextLayoutExtents(). ascent and
+// descent are the distances from the baseline to the top and bottom
+// of a line of text, lineHeight is the height of a single line of
+// unattributed text, and avgCharWidth is the approximate width of an
+// average character. Any of the output pointers may be NULL.
+// The resolved font is cached, so this is much cheaper than creating
+// a uiDrawTextLayout, which makes it suitable for virtual layouts that
+// only need to know how big lines of text are.
+_UI_EXTERN void uiFontMetrics(const uiFontDescriptor *desc, double *ascent, double *descent, double *lineHeight, double *avgCharWidth);
+
+// uiListFontFamiliesFunc is the type of the function invoked by
+// uiListFontFamilies() for every font family. family is only valid
+// for the duration of the call.
+typedef uiForEach (*uiListFontFamiliesFunc)(const char *family, void *data);
+
+// uiListFontFamilies() calls f for the name of every font family
+// installed on the system, in no particular order, until f returns
+// uiForEachStop. Where enumerating fonts is expensive, the list is
+// cached and only refreshed when the installed fonts change, so this
+// is cheap to call every time your own font picker is shown.
+_UI_EXTERN void uiListFontFamilies(uiListFontFamiliesFunc f, void *data);
+
+// uiFontWarmUpStats() returns nonzero if the font warm-up requested
+// with uiInitFlagWarmUpFonts has finished, and if so stores the
+// number of seconds it took in seconds (if not NULL). It returns 0 if
+// the warm-up is still running or was never requested.
+_UI_EXTERN int uiFontWarmUpStats(double *seconds);
+
 // uiDrawTextLayout is a concrete representation of a
 // uiAttributedString that can be displayed in a uiDrawContext.
 // It includes information important for the drawing of a block of
@@ -2682,6 +3018,17 @@ struct uiDrawTextLayoutParams {
 // - some function to fix up a range (for text editing)
 _UI_EXTERN uiDrawTextLayout *uiDrawNewTextLayout(uiDrawTextLayoutParams *params);
 
+// uiDrawNewTextLayoutAsync() is like uiDrawNewTextLayout(), except
+// that the text is laid out in the background where possible, so that
+// laying out very long strings does not block the UI. f is called on
+// the main thread with the finished uiDrawTextLayout, which you own
+// and must free with uiDrawFreeTextLayout() as usual; f is never
+// called before uiDrawNewTextLayoutAsync() returns. Everything
+// needed from params is copied before uiDrawNewTextLayoutAsync()
+// returns, so you may modify or free params->String right away.
+// Layouts still pending at uiUninit() are freed without f being called.
+_UI_EXTERN void uiDrawNewTextLayoutAsync(uiDrawTextLayoutParams *params, void (*f)(uiDrawTextLayout *tl, void *data), void *data);
+
 // @role uiDrawFreeTextLayout destructor
 // uiDrawFreeTextLayout() frees tl. The underlying
 // uiAttributedString is not freed.
@@ -2697,10 +3044,83 @@ _UI_EXTERN void uiDrawText(uiDrawContext *c, uiDrawTextLayout *tl, double x, dou
 // function to get the actual size of the text layout.
 _UI_EXTERN void uiDrawTextLayoutExtents(uiDrawTextLayout *tl, double *width, double *height);
 
+// uiDrawMeasureTexts() measures n unattributed strings in the font
+// desc and stores the size of each in widths[i] and heights[i]. The
+// results are the same as what uiDrawTextLayoutExtents() would
+// return for a uiDrawTextLayout made from each string with a Width
+// of -1 (no wrapping), but without having to create a
+// uiAttributedString and a uiDrawTextLayout for each string. This is
+// useful for autosizing columns in tables drawn in a uiArea.
+// Either widths or heights may be NULL if you don't need them.
+_UI_EXTERN void uiDrawMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights);
+
 // TODO metrics functions
 
 // TODO number of lines visible for clipping rect, range visible for clipping rect?
 
+// uiDrawList records a sequence of drawing operations so they can be
+// drawn again later without running the code that made them. Use
+// one for the parts of a uiArea that don't change from one Draw to
+// the next.
+//
+// A uiDrawList works out the bounds of everything it records, so
+// when it's drawn, operations that fall entirely outside the area
+// being redrawn are skipped.
+//
+// Paths and text layouts are not copied; they must stay alive (and,
+// for paths, ended) until the uiDrawList is freed. Brushes and
+// stroke parameters are copied, and brushes are converted as with
+// uiDrawNewBrush().
+typedef struct uiDrawList uiDrawList;
+
+_UI_EXTERN uiDrawList *uiDrawNewList(void);
+_UI_EXTERN void uiDrawFreeList(uiDrawList *l);
+
+// These record the corresponding uiDraw*() call.
+_UI_EXTERN void uiDrawListStroke(uiDrawList *l, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p);
+_UI_EXTERN void uiDrawListFill(uiDrawList *l, uiDrawPath *path, uiDrawBrush *b);
+_UI_EXTERN void uiDrawListText(uiDrawList *l, uiDrawTextLayout *tl, double x, double y);
+_UI_EXTERN void uiDrawListTransform(uiDrawList *l, uiDrawMatrix *m);
+_UI_EXTERN void uiDrawListClip(uiDrawList *l, uiDrawPath *path);
+_UI_EXTERN void uiDrawListSave(uiDrawList *l);
+_UI_EXTERN void uiDrawListRestore(uiDrawList *l);
+
+// uiDrawListDraw() draws l into c, skipping operations that lie
+// entirely outside the given clip rectangle. The clip rectangle is in
+// the coordinates of c at the time of the call; if you haven't
+// transformed c, just pass the Clip fields of your uiAreaDrawParams.
+// Any transforms and clips in l are undone before
+// uiDrawListDraw() returns.
+_UI_EXTERN void uiDrawListDraw(uiDrawContext *c, uiDrawList *l, double clipX, double clipY, double clipWidth, double clipHeight);
+
+// uiDrawSpatialIndex finds which of many rectangles overlap a point or
+// another rectangle without looking at each of them; use it to find the
+// shapes under the mouse in a uiArea that draws lots of them. Each
+// rectangle comes with a data pointer of your choosing, usually the
+// object it's the bounds of; uiDrawPathBounds() gives you the bounds
+// of a uiDrawPath. Queries take time logarithmic in the number of
+// rectangles.
+//
+// The index is rebuilt the first time it's queried after a change, so
+// add or remove everything you need to before querying again.
+typedef struct uiDrawSpatialIndex uiDrawSpatialIndex;
+
+_UI_EXTERN uiDrawSpatialIndex *uiDrawNewSpatialIndex(void);
+_UI_EXTERN void uiDrawFreeSpatialIndex(uiDrawSpatialIndex *si);
+_UI_EXTERN void uiDrawSpatialIndexAdd(uiDrawSpatialIndex *si, double x, double y, double width, double height, void *data);
+// uiDrawSpatialIndexRemove() removes every rectangle added with data.
+_UI_EXTERN void uiDrawSpatialIndexRemove(uiDrawSpatialIndex *si, void *data);
+_UI_EXTERN size_t uiDrawSpatialIndexCount(uiDrawSpatialIndex *si);
+
+// uiDrawSpatialIndexQuery() calls f with the data pointer of every
+// rectangle that overlaps the rectangle (x, y, width, height), in no
+// particular order; pass a width and height of 0 to query a single
+// point. Rectangles that only touch the edge of the query count. If f
+// returns uiForEachStop, the query stops. You must not add to or
+// remove from si during the query.
+typedef uiForEach (*uiDrawSpatialIndexQueryFunc)(uiDrawSpatialIndex *si, void *data, void *senderData);
+_UI_EXTERN void uiDrawSpatialIndexQuery(uiDrawSpatialIndex *si, double x, double y, double width, double height, uiDrawSpatialIndexQueryFunc f, void *senderData);
+
 
 /**
  * A button-like control that opens a font chooser when clicked.
@@ -3176,6 +3596,39 @@ _UI_EXTERN void uiFreeImage(uiImage *i);
  */
 _UI_EXTERN void uiImageAppend(uiImage *i, void *pixels, int pixelWidth, int pixelHeight, int byteStride);
 
+/**
+ * Resampling filters used when drawing a uiImage at a size other than
+ * that of its pixels.
+ *
+ * Used in uiDrawImage().
+ * @enum uiDrawImageFilter
+ */
+_UI_ENUM(uiDrawImageFilter) {
+	uiDrawImageFilterNearest,	//!< Nearest neighbor; keeps pixel art sharp.
+	uiDrawImageFilterLinear,	//!< Bilinear interpolation.
+	uiDrawImageFilterSmooth,	//!< Highest quality the system offers.
+};
+
+/**
+ * Draws an image into a drawing context.
+ *
+ * The image representation closest to the size the image will have on
+ * the screen is picked, taking the current transform and the pixel
+ * density into account. If it has to be resized, the resized copy is
+ * kept with the image, so drawing the same image at the same size again
+ * (as with icons and sprites) does not resample it every time.
+ *
+ * @param c Drawing context.
+ * @param i uiImage instance.
+ * @param x X coordinate of the top-left corner.
+ * @param y Y coordinate of the top-left corner.
+ * @param width Width to draw the image at.
+ * @param height Height to draw the image at.
+ * @param filter Resampling filter.
+ * @memberof uiImage
+ */
+_UI_EXTERN void uiDrawImage(uiDrawContext *c, uiImage *i, double x, double y, double width, double height, uiDrawImageFilter filter);
+
 /**
  * @addtogroup table
  * @{
@@ -3,6 +3,8 @@
 #include "uipriv_unix.h"
 
 static GPtrArray *allocations;
+// the drawing functions can be called from the worker threads of tiled uiAreas, and they allocate
+static GMutex allocationsLock;
 
 #define UINT8(p) ((uint8_t *) (p))
 #define PVOID(p) ((void *) (p))
@@ -50,7 +52,9 @@ void *uiprivAlloc(size_t size, const char *type)
 	out = g_malloc0(EXTRA + size);
 	*SIZE(out) = size;
 	*TYPE(out) = type;
+	g_mutex_lock(&allocationsLock);
 	g_ptr_array_add(allocations, out);
+	g_mutex_unlock(&allocationsLock);
 	return DATA(out);
 }
 
@@ -58,6 +62,7 @@ void *uiprivRealloc(void *p, size_t new, const char *type)
 {
 	void *out;
 	size_t *s;
+	gboolean removed;
 
 	if (p == NULL)
 		return uiprivAlloc(new, type);
@@ -67,18 +72,26 @@ void *uiprivRealloc(void *p, size_t new, const char *type)
 	if (new > *s)
 		memset(((uint8_t *) DATA(out)) + *s, 0, new - *s);
 	*s = new;
-	if (g_ptr_array_remove(allocations, p) == FALSE)
-		uiprivImplBug("%p not found in allocations array in uiprivRealloc()", p);
+	g_mutex_lock(&allocationsLock);
+	removed = g_ptr_array_remove(allocations, p);
 	g_ptr_array_add(allocations, out);
+	g_mutex_unlock(&allocationsLock);
+	if (removed == FALSE)
+		uiprivImplBug("%p not found in allocations array in uiprivRealloc()", p);
 	return DATA(out);
 }
 
 void uiprivFree(void *p)
 {
+	gboolean removed;
+
 	if (p == NULL)
 		uiprivImplBug("attempt to uiprivFree(NULL)");
 	p = BASE(p);
 	g_free(p);
-	if (g_ptr_array_remove(allocations, p) == FALSE)
+	g_mutex_lock(&allocationsLock);
+	removed = g_ptr_array_remove(allocations, p);
+	g_mutex_unlock(&allocationsLock);
+	if (removed == FALSE)
 		uiprivImplBug("%p not found in allocations array in uiprivFree()", p);
 }
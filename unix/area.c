@@ -49,6 +49,33 @@ struct uiArea {
 
 	// for user window drags
 	GdkEventButton *dragevent;
+
+	// for uiAreaSetAnimationCallback()
+	guint tickID;
+	uiAreaAnimationFunc animate;
+	void *animateData;
+
+	// for uiAreaSetTiledRendering(); tileSize is 0 if tiled rendering is off
+	int tileSize;
+	GThreadPool *tilePool;
+
+	// for uiAreaSetBackingStore(); cache is NULL if nothing has been drawn into it yet
+	gboolean backingStore;
+	int backingMargin;
+	cairo_surface_t *cache;
+	// the cache is swapped with this when scrolling, so we don't have to make a new surface every time
+	cairo_surface_t *spareCache;
+	int cacheScale;
+	// both of these are in area coordinates
+	cairo_rectangle_int_t cacheRect;
+	cairo_region_t *cacheValid;
+
+	// for uiAreaSetResizePolicy()
+	uiAreaResizePolicy resizePolicy;
+	// for uiAreaResizeDeferred; lastFrame is everything last drawn, and resizeTimer is nonzero while the size is still changing
+	cairo_surface_t *lastFrame;
+	int lastFrameScale;
+	guint resizeTimer;
 };
 
 G_DEFINE_TYPE(areaWidget, areaWidget, GTK_TYPE_DRAWING_AREA)
@@ -81,21 +108,47 @@ static void areaWidget_finalize(GObject *obj)
 	G_OBJECT_CLASS(areaWidget_parent_class)->finalize(obj);
 }
 
+// how long the size must stay the same before uiAreaResizeDeferred redraws everything, in milliseconds
+#define resizeSettleTime 150
+
+static gboolean resizeSettled(gpointer data)
+{
+	uiArea *a = uiArea(data);
+
+	a->resizeTimer = 0;
+	gtk_widget_queue_draw(a->areaWidget);
+	return G_SOURCE_REMOVE;
+}
+
+static void stopResizeTimer(uiArea *a)
+{
+	if (a->resizeTimer != 0)
+		g_source_remove(a->resizeTimer);
+	a->resizeTimer = 0;
+}
+
+static void restartResizeTimer(uiArea *a)
+{
+	stopResizeTimer(a);
+	a->resizeTimer = g_timeout_add(resizeSettleTime, resizeSettled, a);
+}
+
 static void areaWidget_size_allocate(GtkWidget *w, GtkAllocation *allocation)
 {
 	areaWidget *aw = areaWidget(w);
 	uiArea *a = aw->a;
+	GtkAllocation old;
 
+	gtk_widget_get_allocation(w, &old);
 	// GtkDrawingArea has a size_allocate() implementation; we need to call it
 	// this will call gtk_widget_set_allocation() for us
 	GTK_WIDGET_CLASS(areaWidget_parent_class)->size_allocate(w, allocation);
 
-	if (!a->scrolling)
-		// we must redraw everything on resize because Windows requires it
-		// TODO https://developer.gnome.org/gtk3/3.10/GtkWidget.html#gtk-widget-set-redraw-on-allocate ?
-		// TODO drop this rule; it was stupid and documenting this was stupid — let platforms where it matters do it on their own
-		// TODO or do we not, for parity of performance?
-		gtk_widget_queue_resize(w);
+	// GTK+ redraws everything on its own after a resize unless we turn that off with gtk_widget_set_redraw_on_allocate(); see uiAreaSetResizePolicy()
+	// we used to also call gtk_widget_queue_resize() here so everything was redrawn everywhere, because Windows requires it, but that made GTK+ lay out the whole window again on every size change for nothing
+	if (!a->scrolling && a->resizePolicy == uiAreaResizeDeferred)
+		if (old.width != allocation->width || old.height != allocation->height)
+			restartResizeTimer(a);
 }
 
 static void loadAreaSize(uiArea *a, double *width, double *height)
@@ -115,10 +168,8 @@ static void loadAreaSize(uiArea *a, double *width, double *height)
 	}
 }
 
-static gboolean areaWidget_draw(GtkWidget *w, cairo_t *cr)
+static void runDraw(uiArea *a, cairo_t *cr)
 {
-	areaWidget *aw = areaWidget(w);
-	uiArea *a = aw->a;
 	uiAreaDrawParams dp;
 	double clipX0, clipY0, clipX1, clipY1;
 
@@ -133,10 +184,354 @@ static gboolean areaWidget_draw(GtkWidget *w, cairo_t *cr)
 	dp.ClipWidth = clipX1 - clipX0;
 	dp.ClipHeight = clipY1 - clipY0;
 
-	// no need to save or restore the graphics state to reset transformations; GTK+ does that for us
 	(*(a->ah->Draw))(a->ah, a, &dp);
 
 	uiprivFreeContext(dp.Context);
+}
+
+// tiles are drawn into image surfaces of their own on the worker threads, then painted onto the widget on the main thread once they're all done
+struct tile {
+	uiArea *a;
+	uiAreaDrawParams dp;
+	int scale;
+	cairo_surface_t *surface;
+	struct tileBatch *batch;
+};
+
+struct tileBatch {
+	GMutex lock;
+	GCond done;
+	int remaining;
+};
+
+static void drawTile(gpointer data, gpointer userData)
+{
+	struct tile *t = (struct tile *) data;
+	cairo_t *cr;
+
+	t->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+		(int) (t->dp.ClipWidth * t->scale),
+		(int) (t->dp.ClipHeight * t->scale));
+	cr = cairo_create(t->surface);
+	// the Draw handler works in area coordinates as usual; this puts the tile's corner at the origin of the surface
+	cairo_scale(cr, t->scale, t->scale);
+	cairo_translate(cr, -t->dp.ClipX, -t->dp.ClipY);
+	cairo_rectangle(cr, t->dp.ClipX, t->dp.ClipY, t->dp.ClipWidth, t->dp.ClipHeight);
+	cairo_clip(cr);
+	// GtkStyleContexts belong to the main thread, so the tile doesn't get one
+	t->dp.Context = uiprivNewContext(cr, NULL);
+	(*(t->a->ah->Draw))(t->a->ah, t->a, &(t->dp));
+	uiprivFreeContext(t->dp.Context);
+	cairo_destroy(cr);
+	cairo_surface_flush(t->surface);
+
+	g_mutex_lock(&(t->batch->lock));
+	t->batch->remaining--;
+	if (t->batch->remaining == 0)
+		g_cond_signal(&(t->batch->done));
+	g_mutex_unlock(&(t->batch->lock));
+}
+
+static gboolean tileDamaged(cairo_rectangle_list_t *rects, int x, int y, int size)
+{
+	cairo_rectangle_t *r;
+	int i;
+
+	// if we don't know which parts are damaged, assume all of them are
+	if (rects->status != CAIRO_STATUS_SUCCESS)
+		return TRUE;
+	for (i = 0; i < rects->num_rectangles; i++) {
+		r = &(rects->rectangles[i]);
+		if (r->x < x + size && r->x + r->width > x &&
+			r->y < y + size && r->y + r->height > y)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+static void runTiledDraw(uiArea *a, cairo_t *cr)
+{
+	cairo_rectangle_list_t *rects;
+	double clipX0, clipY0, clipX1, clipY1;
+	double areaWidth, areaHeight;
+	int x0, y0, x1, y1, x, y;
+	int scale;
+	struct tileBatch batch;
+	struct tile *tiles;
+	int n, i;
+
+	loadAreaSize(a, &areaWidth, &areaHeight);
+	scale = gtk_widget_get_scale_factor(a->areaWidget);
+	rects = cairo_copy_clip_rectangle_list(cr);
+	cairo_clip_extents(cr, &clipX0, &clipY0, &clipX1, &clipY1);
+	// line the tiles up on a grid so the same tile covers the same part of the area from one redraw to the next
+	x0 = ((int) floor(clipX0 / a->tileSize)) * a->tileSize;
+	y0 = ((int) floor(clipY0 / a->tileSize)) * a->tileSize;
+	x1 = (int) ceil(clipX1);
+	y1 = (int) ceil(clipY1);
+
+	n = 0;
+	for (y = y0; y < y1; y += a->tileSize)
+		for (x = x0; x < x1; x += a->tileSize)
+			if (tileDamaged(rects, x, y, a->tileSize))
+				n++;
+	if (n == 0) {
+		cairo_rectangle_list_destroy(rects);
+		return;
+	}
+	tiles = (struct tile *) uiprivAlloc(n * sizeof (struct tile), "struct tile[]");
+	g_mutex_init(&(batch.lock));
+	g_cond_init(&(batch.done));
+	batch.remaining = n;
+	i = 0;
+	for (y = y0; y < y1; y += a->tileSize)
+		for (x = x0; x < x1; x += a->tileSize) {
+			if (!tileDamaged(rects, x, y, a->tileSize))
+				continue;
+			tiles[i].a = a;
+			tiles[i].dp.AreaWidth = areaWidth;
+			tiles[i].dp.AreaHeight = areaHeight;
+			tiles[i].dp.ClipX = x;
+			tiles[i].dp.ClipY = y;
+			tiles[i].dp.ClipWidth = a->tileSize;
+			tiles[i].dp.ClipHeight = a->tileSize;
+			tiles[i].scale = scale;
+			tiles[i].batch = &batch;
+			g_thread_pool_push(a->tilePool, &(tiles[i]), NULL);
+			i++;
+		}
+	cairo_rectangle_list_destroy(rects);
+
+	g_mutex_lock(&(batch.lock));
+	while (batch.remaining != 0)
+		g_cond_wait(&(batch.done), &(batch.lock));
+	g_mutex_unlock(&(batch.lock));
+	g_cond_clear(&(batch.done));
+	g_mutex_clear(&(batch.lock));
+
+	// cr is still clipped to the damaged region, so tiles that stick out of it don't paint anything they shouldn't
+	for (i = 0; i < n; i++) {
+		cairo_save(cr);
+		cairo_translate(cr, tiles[i].dp.ClipX, tiles[i].dp.ClipY);
+		cairo_scale(cr, 1.0 / scale, 1.0 / scale);
+		cairo_set_source_surface(cr, tiles[i].surface, 0, 0);
+		cairo_paint(cr);
+		cairo_restore(cr);
+		cairo_surface_destroy(tiles[i].surface);
+	}
+	uiprivFree(tiles);
+}
+
+// if only a few small parts of the area were invalidated, drawing everything between them would be a waste
+// these decide when to call Draw once per rectangle instead
+#define maxSeparateRects 8
+#define separateRectsMaxCoverage 0.5
+
+// this draws whatever is inside the clip of cr, which is in area coordinates
+static void drawRegion(uiArea *a, cairo_t *cr)
+{
+	cairo_rectangle_list_t *rects;
+	double clipX0, clipY0, clipX1, clipY1;
+	double area;
+	int i;
+
+	if (a->tileSize != 0) {
+		runTiledDraw(a, cr);
+		return;
+	}
+
+	rects = cairo_copy_clip_rectangle_list(cr);
+	if (rects->status != CAIRO_STATUS_SUCCESS || rects->num_rectangles <= 1 || rects->num_rectangles > maxSeparateRects) {
+		cairo_rectangle_list_destroy(rects);
+		runDraw(a, cr);
+		return;
+	}
+	area = 0;
+	for (i = 0; i < rects->num_rectangles; i++)
+		area += rects->rectangles[i].width * rects->rectangles[i].height;
+	cairo_clip_extents(cr, &clipX0, &clipY0, &clipX1, &clipY1);
+	if (area > (clipX1 - clipX0) * (clipY1 - clipY0) * separateRectsMaxCoverage) {
+		cairo_rectangle_list_destroy(rects);
+		runDraw(a, cr);
+		return;
+	}
+	for (i = 0; i < rects->num_rectangles; i++) {
+		cairo_save(cr);
+		cairo_rectangle(cr,
+			rects->rectangles[i].x,
+			rects->rectangles[i].y,
+			rects->rectangles[i].width,
+			rects->rectangles[i].height);
+		cairo_clip(cr);
+		runDraw(a, cr);
+		cairo_restore(cr);
+	}
+	cairo_rectangle_list_destroy(rects);
+}
+
+static void freeCache(uiArea *a)
+{
+	if (a->cache != NULL)
+		cairo_surface_destroy(a->cache);
+	a->cache = NULL;
+	if (a->spareCache != NULL)
+		cairo_surface_destroy(a->spareCache);
+	a->spareCache = NULL;
+	if (a->cacheValid != NULL)
+		cairo_region_destroy(a->cacheValid);
+	a->cacheValid = NULL;
+}
+
+static cairo_surface_t *newCacheSurface(uiArea *a, int width, int height, int scale)
+{
+	// this takes care of the scale for us, so the drawing code can keep using area coordinates
+	return gdk_window_create_similar_image_surface(gtk_widget_get_window(a->areaWidget),
+		CAIRO_FORMAT_ARGB32, width * scale, height * scale, scale);
+}
+
+// the cache covers the visible part of the area plus a margin, so scrolling a little doesn't need to call Draw at all
+// and when scrolling does need to call Draw, it only needs to for the strips that just came into the margin
+static void drawCached(uiArea *a, cairo_t *cr)
+{
+	GtkAdjustment *hadj, *vadj;
+	cairo_rectangle_int_t r;
+	cairo_surface_t *old;
+	cairo_region_t *invalid;
+	cairo_t *ccr;
+	int x1, y1;
+	int scale;
+
+	hadj = gtk_scrolled_window_get_hadjustment(a->sw);
+	vadj = gtk_scrolled_window_get_vadjustment(a->sw);
+	r.x = (int) floor(gtk_adjustment_get_value(hadj)) - a->backingMargin;
+	r.y = (int) floor(gtk_adjustment_get_value(vadj)) - a->backingMargin;
+	x1 = (int) ceil(gtk_adjustment_get_value(hadj) + gtk_adjustment_get_page_size(hadj)) + a->backingMargin;
+	y1 = (int) ceil(gtk_adjustment_get_value(vadj) + gtk_adjustment_get_page_size(vadj)) + a->backingMargin;
+	// there's nothing to draw outside the area
+	r.x = MAX(r.x, 0);
+	r.y = MAX(r.y, 0);
+	x1 = MIN(x1, a->scrollWidth);
+	y1 = MIN(y1, a->scrollHeight);
+	if (x1 <= r.x || y1 <= r.y)
+		return;
+	r.width = x1 - r.x;
+	r.height = y1 - r.y;
+
+	scale = gtk_widget_get_scale_factor(a->areaWidget);
+	if (a->cache == NULL || scale != a->cacheScale || r.width != a->cacheRect.width || r.height != a->cacheRect.height) {
+		freeCache(a);
+		a->cache = newCacheSurface(a, r.width, r.height, scale);
+		a->cacheScale = scale;
+		a->cacheValid = cairo_region_create();
+	} else if (r.x != a->cacheRect.x || r.y != a->cacheRect.y) {
+		// the area scrolled; move what we already have to where it is now
+		if (a->spareCache == NULL)
+			a->spareCache = newCacheSurface(a, r.width, r.height, scale);
+		old = a->cache;
+		a->cache = a->spareCache;
+		a->spareCache = old;
+		ccr = cairo_create(a->cache);
+		cairo_set_operator(ccr, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface(ccr, old, a->cacheRect.x - r.x, a->cacheRect.y - r.y);
+		cairo_paint(ccr);
+		cairo_destroy(ccr);
+	}
+	a->cacheRect = r;
+	cairo_region_intersect_rectangle(a->cacheValid, &r);
+
+	invalid = cairo_region_create_rectangle(&r);
+	cairo_region_subtract(invalid, a->cacheValid);
+	if (!cairo_region_is_empty(invalid)) {
+		ccr = cairo_create(a->cache);
+		cairo_translate(ccr, -r.x, -r.y);
+		gdk_cairo_region(ccr, invalid);
+		cairo_clip(ccr);
+		// whatever was here before is stale (or garbage from the swap above), and Draw expects to draw on top of nothing
+		cairo_save(ccr);
+		cairo_set_operator(ccr, CAIRO_OPERATOR_CLEAR);
+		cairo_paint(ccr);
+		cairo_restore(ccr);
+		drawRegion(a, ccr);
+		cairo_destroy(ccr);
+		cairo_region_union(a->cacheValid, invalid);
+	}
+	cairo_region_destroy(invalid);
+
+	// cr is already clipped to what GTK+ wants redrawn
+	cairo_set_source_surface(cr, a->cache, r.x, r.y);
+	cairo_paint(cr);
+}
+
+// with uiAreaResizeDeferred, everything goes through lastFrame, so there's always something to stretch when the size starts changing
+static void drawDeferred(uiArea *a, cairo_t *cr)
+{
+	int width, height;
+	int scale;
+	cairo_rectangle_list_t *rects;
+	cairo_t *fcr;
+	int i;
+
+	width = gtk_widget_get_allocated_width(a->areaWidget);
+	height = gtk_widget_get_allocated_height(a->areaWidget);
+	if (width <= 0 || height <= 0)
+		return;
+	if (a->resizeTimer != 0 && a->lastFrame != NULL) {
+		cairo_scale(cr,
+			((double) width) / cairo_image_surface_get_width(a->lastFrame) * a->lastFrameScale,
+			((double) height) / cairo_image_surface_get_height(a->lastFrame) * a->lastFrameScale);
+		cairo_set_source_surface(cr, a->lastFrame, 0, 0);
+		cairo_paint(cr);
+		return;
+	}
+
+	scale = gtk_widget_get_scale_factor(a->areaWidget);
+	fcr = NULL;
+	if (a->lastFrame == NULL || scale != a->lastFrameScale ||
+		cairo_image_surface_get_width(a->lastFrame) != width * scale ||
+		cairo_image_surface_get_height(a->lastFrame) != height * scale) {
+		if (a->lastFrame != NULL)
+			cairo_surface_destroy(a->lastFrame);
+		a->lastFrame = newCacheSurface(a, width, height, scale);
+		a->lastFrameScale = scale;
+		// a new frame has nothing in it, so it all needs drawing, not just what GTK+ asked for
+		fcr = cairo_create(a->lastFrame);
+	} else {
+		fcr = cairo_create(a->lastFrame);
+		rects = cairo_copy_clip_rectangle_list(cr);
+		if (rects->status == CAIRO_STATUS_SUCCESS) {
+			for (i = 0; i < rects->num_rectangles; i++)
+				cairo_rectangle(fcr,
+					rects->rectangles[i].x,
+					rects->rectangles[i].y,
+					rects->rectangles[i].width,
+					rects->rectangles[i].height);
+			cairo_clip(fcr);
+		}
+		cairo_rectangle_list_destroy(rects);
+	}
+	cairo_save(fcr);
+	cairo_set_operator(fcr, CAIRO_OPERATOR_CLEAR);
+	cairo_paint(fcr);
+	cairo_restore(fcr);
+	drawRegion(a, fcr);
+	cairo_destroy(fcr);
+
+	cairo_set_source_surface(cr, a->lastFrame, 0, 0);
+	cairo_paint(cr);
+}
+
+static gboolean areaWidget_draw(GtkWidget *w, cairo_t *cr)
+{
+	areaWidget *aw = areaWidget(w);
+	uiArea *a = aw->a;
+
+	// no need to save or restore the graphics state to reset transformations; GTK+ does that for us
+	if (a->backingStore)
+		drawCached(a, cr);
+	else if (!a->scrolling && a->resizePolicy == uiAreaResizeDeferred)
+		drawDeferred(a, cr);
+	else
+		drawRegion(a, cr);
 	return FALSE;
 }
 
@@ -494,7 +889,22 @@ static void areaWidget_class_init(areaWidgetClass *class)
 
 // control implementation
 
-uiUnixControlAllDefaults(uiArea)
+uiUnixControlAllDefaultsExceptDestroy(uiArea)
+
+static void uiAreaDestroy(uiControl *c)
+{
+	uiArea *a = uiArea(c);
+
+	// nothing is ever left in the pool; runTiledDraw() waits for every tile it queues
+	if (a->tilePool != NULL)
+		g_thread_pool_free(a->tilePool, FALSE, TRUE);
+	freeCache(a);
+	stopResizeTimer(a);
+	if (a->lastFrame != NULL)
+		cairo_surface_destroy(a->lastFrame);
+	g_object_unref(a->widget);
+	uiFreeControl(uiControl(a));
+}
 
 void uiAreaSetSize(uiArea *a, int width, int height)
 {
@@ -507,13 +917,157 @@ void uiAreaSetSize(uiArea *a, int width, int height)
 
 void uiAreaQueueRedrawAll(uiArea *a)
 {
+	if (a->cacheValid != NULL) {
+		cairo_region_destroy(a->cacheValid);
+		a->cacheValid = cairo_region_create();
+	}
 	gtk_widget_queue_draw(a->areaWidget);
 }
 
+// GDK collects everything we queue here into the window's invalid region until the next frame, so this coalesces on its own
+// we just need to make sure the pixels that are partially covered are included
+static void addRect(cairo_region_t *region, double x, double y, double width, double height)
+{
+	cairo_rectangle_int_t r;
+
+	if (width <= 0 || height <= 0)
+		return;
+	r.x = (int) floor(x);
+	r.y = (int) floor(y);
+	r.width = (int) ceil(x + width) - r.x;
+	r.height = (int) ceil(y + height) - r.y;
+	cairo_region_union_rectangle(region, &r);
+}
+
+void uiAreaQueueRedrawRect(uiArea *a, double x, double y, double width, double height)
+{
+	double r[4];
+
+	r[0] = x;
+	r[1] = y;
+	r[2] = width;
+	r[3] = height;
+	uiAreaQueueRedrawRects(a, r, 1);
+}
+
+void uiAreaQueueRedrawRects(uiArea *a, const double *rects, size_t n)
+{
+	cairo_region_t *region;
+	size_t i;
+
+	region = cairo_region_create();
+	for (i = 0; i < n; i++, rects += 4)
+		addRect(region, rects[0], rects[1], rects[2], rects[3]);
+	if (a->cacheValid != NULL)
+		cairo_region_subtract(a->cacheValid, region);
+	// the area widget's coordinates are the same as drawing coordinates, even for scrolling areas
+	if (!cairo_region_is_empty(region))
+		gtk_widget_queue_draw_region(a->areaWidget, region);
+	cairo_region_destroy(region);
+}
+
 void uiAreaScrollTo(uiArea *a, double x, double y, double width, double height)
 {
-	// TODO
-	// TODO adjust adjustments and find source for that
+	if (!a->scrolling)
+		uiprivUserBug("You cannot call uiAreaScrollTo() on a non-scrolling uiArea. (area: %p)", a);
+	// this does exactly what we want, including favoring the top-left corner if the rectangle doesn't fit
+	gtk_adjustment_clamp_page(gtk_scrolled_window_get_hadjustment(a->sw), x, x + width);
+	gtk_adjustment_clamp_page(gtk_scrolled_window_get_vadjustment(a->sw), y, y + height);
+}
+
+void uiAreaSetBackingStore(uiArea *a, int enabled, double margin)
+{
+	if (!a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetBackingStore() on a non-scrolling uiArea. (area: %p)", a);
+	if (margin < 0)
+		uiprivUserBug("You cannot give a uiArea backing store a negative margin (%g). (area: %p)", margin, a);
+	freeCache(a);
+	a->backingStore = enabled != 0;
+	a->backingMargin = (int) ceil(margin);
+	uiAreaQueueRedrawAll(a);
+}
+
+double uiAreaScaleFactor(uiArea *a)
+{
+	return gtk_widget_get_scale_factor(a->areaWidget);
+}
+
+// the frame clock runs in step with the compositor, so this is as close to vsync as GTK+ lets us get
+// the tick callback goes away with the widget, so there's nothing to clean up when the uiArea is destroyed
+static gboolean areaTick(GtkWidget *widget, GdkFrameClock *clock, gpointer data)
+{
+	uiArea *a = uiArea(data);
+	GdkFrameTimings *timings;
+	gint64 frameTime, presentationTime;
+	guint id;
+
+	frameTime = gdk_frame_clock_get_frame_time(clock);
+	presentationTime = 0;
+	timings = gdk_frame_clock_get_current_timings(clock);
+	if (timings != NULL)
+		presentationTime = gdk_frame_timings_get_predicted_presentation_time(timings);
+	// this is 0 if GDK has no idea yet (for instance, before the first frame has been presented)
+	if (presentationTime == 0)
+		presentationTime = frameTime;
+	id = a->tickID;
+	if ((*(a->animate))(a, frameTime / 1000000.0, presentationTime / 1000000.0, a->animateData))
+		return G_SOURCE_CONTINUE;
+	// f may have replaced itself with another callback; if so, leave that one alone
+	if (a->tickID != id)
+		return G_SOURCE_REMOVE;
+	a->tickID = 0;
+	a->animate = NULL;
+	a->animateData = NULL;
+	return G_SOURCE_REMOVE;
+}
+
+void uiAreaSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data)
+{
+	if (a->tickID != 0) {
+		gtk_widget_remove_tick_callback(a->areaWidget, a->tickID);
+		a->tickID = 0;
+	}
+	a->animate = f;
+	a->animateData = data;
+	if (f != NULL)
+		a->tickID = gtk_widget_add_tick_callback(a->areaWidget, areaTick, a, NULL);
+}
+
+void uiAreaSetTiledRendering(uiArea *a, int tileSize, int threads)
+{
+	GError *err = NULL;
+
+	if (tileSize < 0)
+		uiprivUserBug("You cannot set a negative tile size (%d) on a uiArea. (area: %p)", tileSize, a);
+	if (threads < 0)
+		uiprivUserBug("You cannot render a uiArea on a negative number of threads (%d). (area: %p)", threads, a);
+	if (a->tilePool != NULL) {
+		g_thread_pool_free(a->tilePool, FALSE, TRUE);
+		a->tilePool = NULL;
+	}
+	a->tileSize = tileSize;
+	if (tileSize != 0) {
+		if (threads == 0)
+			threads = g_get_num_processors();
+		a->tilePool = g_thread_pool_new(drawTile, NULL, threads, FALSE, &err);
+		if (a->tilePool == NULL)
+			uiprivImplBug("error creating uiArea tile thread pool: %s", err->message);
+	}
+	uiAreaQueueRedrawAll(a);
+}
+
+void uiAreaSetResizePolicy(uiArea *a, uiAreaResizePolicy policy)
+{
+	if (a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetResizePolicy() on a scrolling uiArea. (area: %p)", a);
+	a->resizePolicy = policy;
+	// GTK+ invalidates the whole widget on every size change unless told otherwise
+	gtk_widget_set_redraw_on_allocate(a->areaWidget, policy != uiAreaResizeRedrawExposed);
+	stopResizeTimer(a);
+	if (a->lastFrame != NULL)
+		cairo_surface_destroy(a->lastFrame);
+	a->lastFrame = NULL;
+	uiAreaQueueRedrawAll(a);
 }
 
 void uiAreaBeginUserWindowMove(uiArea *a)
@@ -15,6 +15,9 @@ extern PangoStyle uiprivItalicToPangoStyle(uiTextItalic i);
 extern PangoStretch uiprivStretchToPangoStretch(uiTextStretch s);
 extern PangoFontDescription *uiprivFontDescriptorToPangoFontDescription(const uiFontDescriptor *uidesc);
 extern void uiprivFontDescriptorFromPangoFontDescription(PangoFontDescription *pdesc, uiFontDescriptor *uidesc);
+extern const PangoFontDescription *uiprivCachedPangoFontDescription(const uiFontDescriptor *uidesc);
+extern PangoFont *uiprivCachedPangoFont(const uiFontDescriptor *uidesc);
+extern PangoFontMetrics *uiprivCachedPangoFontMetrics(const uiFontDescriptor *uidesc);
 
 // attrstr.c
 extern PangoAttrList *uiprivAttributedStringToPangoAttrList(uiDrawTextLayoutParams *p);
@@ -9,24 +9,90 @@ uiDrawContext *uiprivNewContext(cairo_t *cr, GtkStyleContext *style)
 	c = uiprivNew(uiDrawContext);
 	c->cr = cr;
 	c->style = style;
+	// uiprivNew() zeroes the state, so it starts out invalid
+	c->savedStates = g_array_new(FALSE, FALSE, sizeof (struct uiprivDrawState));
 	return c;
 }
 
 void uiprivFreeContext(uiDrawContext *c)
 {
 	// free neither cr nor style; we own neither
+	g_array_free(c->savedStates, TRUE);
 	uiprivFree(c);
 }
 
-static cairo_pattern_t *mkbrush(uiDrawBrush *b)
+// frames tend to use the same handful of solid colors over and over, so keep the patterns for the most recent ones around instead of making new ones every time
+#define solidCacheSize 16
+
+struct solidCacheEntry {
+	double r, g, b, a;
+	cairo_pattern_t *pat;
+};
+
+static struct solidCacheEntry solidCache[solidCacheSize];
+static int solidCacheNext = 0;
+// tiled uiAreas make brushes on several threads at once
+static GMutex solidCacheLock;
+
+static cairo_pattern_t *checkPattern(cairo_pattern_t *pat)
+{
+	if (cairo_pattern_status(pat) != CAIRO_STATUS_SUCCESS)
+		uiprivImplBug("error creating pattern in mkbrush(): %s",
+			cairo_status_to_string(cairo_pattern_status(pat)));
+	return pat;
+}
+
+static cairo_pattern_t *solidPattern(double r, double g, double b, double a)
+{
+	struct solidCacheEntry *e;
+	cairo_pattern_t *pat;
+	int i;
+
+	g_mutex_lock(&solidCacheLock);
+	for (i = 0; i < solidCacheSize; i++) {
+		e = &(solidCache[i]);
+		if (e->pat != NULL && e->r == r && e->g == g && e->b == b && e->a == a) {
+			pat = cairo_pattern_reference(e->pat);
+			g_mutex_unlock(&solidCacheLock);
+			return pat;
+		}
+	}
+	// replace the oldest entry
+	e = &(solidCache[solidCacheNext]);
+	solidCacheNext = (solidCacheNext + 1) % solidCacheSize;
+	if (e->pat != NULL)
+		cairo_pattern_destroy(e->pat);
+	e->r = r;
+	e->g = g;
+	e->b = b;
+	e->a = a;
+	e->pat = checkPattern(cairo_pattern_create_rgba(r, g, b, a));
+	pat = cairo_pattern_reference(e->pat);
+	g_mutex_unlock(&solidCacheLock);
+	return pat;
+}
+
+void uiprivUninitDraw(void)
+{
+	int i;
+
+	for (i = 0; i < solidCacheSize; i++) {
+		if (solidCache[i].pat != NULL)
+			cairo_pattern_destroy(solidCache[i].pat);
+		solidCache[i].pat = NULL;
+	}
+	solidCacheNext = 0;
+}
+
+// the returned pattern is always a new reference; destroy it when done
+static cairo_pattern_t *mkbrush(const uiDrawBrush *b)
 {
 	cairo_pattern_t *pat;
 	size_t i;
 
 	switch (b->Type) {
 	case uiDrawBrushTypeSolid:
-		pat = cairo_pattern_create_rgba(b->R, b->G, b->B, b->A);
-		break;
+		return solidPattern(b->R, b->G, b->B, b->A);
 	case uiDrawBrushTypeLinearGradient:
 		pat = cairo_pattern_create_linear(b->X0, b->Y0, b->X1, b->Y1);
 		break;
@@ -38,78 +104,299 @@ static cairo_pattern_t *mkbrush(uiDrawBrush *b)
 		break;
 //	case uiDrawBrushTypeImage:
 	}
-	if (cairo_pattern_status(pat) != CAIRO_STATUS_SUCCESS)
-		uiprivImplBug("error creating pattern in mkbrush(): %s",
-			cairo_status_to_string(cairo_pattern_status(pat)));
-	switch (b->Type) {
-	case uiDrawBrushTypeLinearGradient:
-	case uiDrawBrushTypeRadialGradient:
-		for (i = 0; i < b->NumStops; i++)
-			cairo_pattern_add_color_stop_rgba(pat,
-				b->Stops[i].Pos,
-				b->Stops[i].R,
-				b->Stops[i].G,
-				b->Stops[i].B,
-				b->Stops[i].A);
-	}
+	checkPattern(pat);
+	for (i = 0; i < b->NumStops; i++)
+		cairo_pattern_add_color_stop_rgba(pat,
+			b->Stops[i].Pos,
+			b->Stops[i].R,
+			b->Stops[i].G,
+			b->Stops[i].B,
+			b->Stops[i].A);
 	return pat;
 }
 
-void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p)
-{
+struct uiDrawCachedBrush {
 	cairo_pattern_t *pat;
+};
 
-	uiprivRunPath(path, c->cr);
-	pat = mkbrush(b);
-	cairo_set_source(c->cr, pat);
-	switch (p->Cap) {
-	case uiDrawLineCapFlat:
-		cairo_set_line_cap(c->cr, CAIRO_LINE_CAP_BUTT);
-		break;
+uiDrawCachedBrush *uiDrawNewBrush(const uiDrawBrush *b)
+{
+	uiDrawCachedBrush *cb;
+
+	cb = uiprivNew(uiDrawCachedBrush);
+	// the color stops are copied into the pattern, so we don't need to keep b around
+	cb->pat = mkbrush(b);
+	return cb;
+}
+
+void uiDrawFreeBrush(uiDrawCachedBrush *b)
+{
+	cairo_pattern_destroy(b->pat);
+	uiprivFree(b);
+}
+
+static cairo_line_cap_t lineCap(uiDrawLineCap cap)
+{
+	switch (cap) {
 	case uiDrawLineCapRound:
-		cairo_set_line_cap(c->cr, CAIRO_LINE_CAP_ROUND);
-		break;
+		return CAIRO_LINE_CAP_ROUND;
 	case uiDrawLineCapSquare:
-		cairo_set_line_cap(c->cr, CAIRO_LINE_CAP_SQUARE);
-		break;
+		return CAIRO_LINE_CAP_SQUARE;
 	}
-	switch (p->Join) {
-	case uiDrawLineJoinMiter:
-		cairo_set_line_join(c->cr, CAIRO_LINE_JOIN_MITER);
-		cairo_set_miter_limit(c->cr, p->MiterLimit);
-		break;
+	return CAIRO_LINE_CAP_BUTT;
+}
+
+static cairo_line_join_t lineJoin(uiDrawLineJoin join)
+{
+	switch (join) {
 	case uiDrawLineJoinRound:
-		cairo_set_line_join(c->cr, CAIRO_LINE_JOIN_ROUND);
-		break;
+		return CAIRO_LINE_JOIN_ROUND;
 	case uiDrawLineJoinBevel:
-		cairo_set_line_join(c->cr, CAIRO_LINE_JOIN_BEVEL);
-		break;
+		return CAIRO_LINE_JOIN_BEVEL;
 	}
-	cairo_set_line_width(c->cr, p->Thickness);
-	cairo_set_dash(c->cr, p->Dashes, p->NumDashes, p->DashPhase);
+	return CAIRO_LINE_JOIN_MITER;
+}
+
+static gboolean sameDashes(struct uiprivDrawState *s, uiDrawStrokeParams *p)
+{
+	size_t i;
+
+	if (p->NumDashes > uiprivMaxTrackedDashes)
+		return FALSE;
+	if (s->numDashes != p->NumDashes)
+		return FALSE;
+	for (i = 0; i < p->NumDashes; i++)
+		if (s->dashes[i] != p->Dashes[i])
+			return FALSE;
+	// cairo ignores the phase without dashes
+	return p->NumDashes == 0 || s->dashPhase == p->DashPhase;
+}
+
+// multiple strokes in a row usually share the same parameters, so only tell cairo what changed since the last one
+static void applyStrokeParams(uiDrawContext *c, uiDrawStrokeParams *p)
+{
+	struct uiprivDrawState *s = &(c->state);
+	cairo_line_cap_t cap;
+	cairo_line_join_t join;
+
+	cap = lineCap(p->Cap);
+	if (s->strokeValid && s->cap == cap)
+		c->stats.SkippedStateChanges++;
+	else
+		cairo_set_line_cap(c->cr, cap);
+	join = lineJoin(p->Join);
+	if (s->strokeValid && s->join == join)
+		c->stats.SkippedStateChanges++;
+	else
+		cairo_set_line_join(c->cr, join);
+	// the miter limit is only used by miter joins, so we only set it for them; other joins leave it alone
+	if (join == CAIRO_LINE_JOIN_MITER) {
+		if (s->strokeValid && s->miterLimit == p->MiterLimit)
+			c->stats.SkippedStateChanges++;
+		else
+			cairo_set_miter_limit(c->cr, p->MiterLimit);
+	}
+	if (s->strokeValid && s->thickness == p->Thickness)
+		c->stats.SkippedStateChanges++;
+	else
+		cairo_set_line_width(c->cr, p->Thickness);
+	if (s->strokeValid && sameDashes(s, p))
+		c->stats.SkippedStateChanges++;
+	else
+		cairo_set_dash(c->cr, p->Dashes, p->NumDashes, p->DashPhase);
+
+	// if the miter limit wasn't set above, cairo still has the old one, if we knew it at all
+	if (join == CAIRO_LINE_JOIN_MITER)
+		s->miterLimit = p->MiterLimit;
+	else if (!s->strokeValid)
+		s->miterLimit = -1;
+	s->cap = cap;
+	s->join = join;
+	s->thickness = p->Thickness;
+	if (p->NumDashes <= uiprivMaxTrackedDashes) {
+		memcpy(s->dashes, p->Dashes, p->NumDashes * sizeof (double));
+		s->numDashes = p->NumDashes;
+	} else
+		// this will never compare equal, so the next stroke always sets dashes again
+		s->numDashes = uiprivMaxTrackedDashes + 1;
+	s->dashPhase = p->DashPhase;
+	s->strokeValid = TRUE;
+}
+
+static void setFillRule(uiDrawContext *c, cairo_fill_rule_t rule)
+{
+	if (c->state.fillRuleValid && c->state.fillRule == rule) {
+		c->stats.SkippedStateChanges++;
+		return;
+	}
+	cairo_set_fill_rule(c->cr, rule);
+	c->state.fillRule = rule;
+	c->state.fillRuleValid = TRUE;
+}
+
+static cairo_fill_rule_t fillRule(uiDrawPath *path)
+{
+	if (uiprivPathFillMode(path) == uiDrawFillModeAlternate)
+		return CAIRO_FILL_RULE_EVEN_ODD;
+	return CAIRO_FILL_RULE_WINDING;
+}
+
+// cairo still flattens, strokes, and rasterizes paths that miss the clip before throwing the result away, so don't give it any
+// both rectangles are in user space; if the transform rotates, cairo_clip_extents() is the bounding box of the rotated clip, so this never culls anything visible
+// paths that touch the clip only at an edge can't cover any pixels inside it, so they can go too
+static gboolean culled(uiDrawContext *c, uiDrawPath *path, double outset)
+{
+	double x, y, width, height;
+	double cx0, cy0, cx1, cy1;
+
+	// let uiprivRunPath() complain about this
+	if (!uiDrawPathEnded(path))
+		return FALSE;
+	if (uiDrawPathBounds(path, &x, &y, &width, &height)) {
+		cairo_clip_extents(c->cr, &cx0, &cy0, &cx1, &cy1);
+		if (x + width + outset > cx0 && x - outset < cx1 &&
+			y + height + outset > cy0 && y - outset < cy1)
+			return FALSE;
+	}
+	c->stats.CulledOperations++;
+	return TRUE;
+}
+
+static void stroke(uiDrawContext *c, uiDrawPath *path, cairo_pattern_t *pat, uiDrawStrokeParams *p)
+{
+	if (culled(c, path, uiprivStrokeOutset(p)))
+		return;
+	uiprivRunPath(path, c->cr);
+	cairo_set_source(c->cr, pat);
+	applyStrokeParams(c, p);
 	cairo_stroke(c->cr);
+}
+
+void uiDrawStroke(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b, uiDrawStrokeParams *p)
+{
+	cairo_pattern_t *pat;
+
+	pat = mkbrush(b);
+	stroke(c, path, pat, p);
 	cairo_pattern_destroy(pat);
 }
 
+void uiDrawStrokeCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b, uiDrawStrokeParams *p)
+{
+	stroke(c, path, b->pat, p);
+}
+
+static void fill(uiDrawContext *c, uiDrawPath *path, cairo_pattern_t *pat)
+{
+	if (culled(c, path, 0))
+		return;
+	uiprivRunPath(path, c->cr);
+	cairo_set_source(c->cr, pat);
+	setFillRule(c, fillRule(path));
+	cairo_fill(c->cr);
+}
+
 void uiDrawFill(uiDrawContext *c, uiDrawPath *path, uiDrawBrush *b)
 {
 	cairo_pattern_t *pat;
 
-	uiprivRunPath(path, c->cr);
+	pat = mkbrush(b);
+	fill(c, path, pat);
+	cairo_pattern_destroy(pat);
+}
+
+void uiDrawFillCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b)
+{
+	fill(c, path, b->pat);
+}
+
+// cairo can only hit-test the current path of a cairo_t, so give it one that never draws anything
+// this only runs on the main thread, but making a new one each time is cheap enough that we don't need to keep one around
+static cairo_t *newHitTestContext(uiDrawPath *path, const char *func)
+{
+	cairo_surface_t *cs;
+	cairo_t *cr;
+
+	if (!uiDrawPathEnded(path))
+		uiprivUserBug("You cannot call %s() on a uiDrawPath that has not been ended. (path: %p)", func, path);
+	cs = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+	cr = cairo_create(cs);
+	// cr holds its own reference
+	cairo_surface_destroy(cs);
+	uiprivRunPathAsCompiled(path, cr);
+	return cr;
+}
+
+int uiDrawPathContainsPoint(uiDrawPath *path, double x, double y)
+{
+	cairo_t *cr;
+	cairo_bool_t in;
+
+	cr = newHitTestContext(path, "uiDrawPathContainsPoint");
+	cairo_set_fill_rule(cr, fillRule(path));
+	in = cairo_in_fill(cr, x, y);
+	cairo_destroy(cr);
+	return in ? 1 : 0;
+}
+
+int uiDrawPathStrokeContainsPoint(uiDrawPath *path, double x, double y, uiDrawStrokeParams *p)
+{
+	cairo_t *cr;
+	cairo_bool_t in;
+
+	cr = newHitTestContext(path, "uiDrawPathStrokeContainsPoint");
+	cairo_set_line_cap(cr, lineCap(p->Cap));
+	cairo_set_line_join(cr, lineJoin(p->Join));
+	cairo_set_miter_limit(cr, p->MiterLimit);
+	cairo_set_line_width(cr, p->Thickness);
+	cairo_set_dash(cr, p->Dashes, p->NumDashes, p->DashPhase);
+	in = cairo_in_stroke(cr, x, y);
+	cairo_destroy(cr);
+	return in ? 1 : 0;
+}
+
+void uiDrawFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b)
+{
+	cairo_pattern_t *pat;
+	size_t i;
+
+	cairo_new_path(c->cr);
+	for (i = 0; i < n; i++, rects += 4)
+		cairo_rectangle(c->cr, rects[0], rects[1], rects[2], rects[3]);
 	pat = mkbrush(b);
 	cairo_set_source(c->cr, pat);
-	switch (uiprivPathFillMode(path)) {
-	case uiDrawFillModeWinding:
-		cairo_set_fill_rule(c->cr, CAIRO_FILL_RULE_WINDING);
-		break;
-	case uiDrawFillModeAlternate:
-		cairo_set_fill_rule(c->cr, CAIRO_FILL_RULE_EVEN_ODD);
-		break;
-	}
+	setFillRule(c, CAIRO_FILL_RULE_WINDING);
 	cairo_fill(c->cr);
 	cairo_pattern_destroy(pat);
 }
 
+static gboolean sameColor(const double *a, const double *b)
+{
+	return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+void uiDrawFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n)
+{
+	size_t i, j;
+
+	setFillRule(c, CAIRO_FILL_RULE_WINDING);
+	for (i = 0; i < n; i = j) {
+		cairo_new_path(c->cr);
+		for (j = i; j < n && sameColor(colors + 4 * i, colors + 4 * j); j++)
+			cairo_rectangle(c->cr,
+				rects[4 * j],
+				rects[4 * j + 1],
+				rects[4 * j + 2],
+				rects[4 * j + 3]);
+		cairo_set_source_rgba(c->cr,
+			colors[4 * i],
+			colors[4 * i + 1],
+			colors[4 * i + 2],
+			colors[4 * i + 3]);
+		cairo_fill(c->cr);
+	}
+}
+
 void uiDrawTransform(uiDrawContext *c, uiDrawMatrix *m)
 {
 	cairo_matrix_t cm;
@@ -121,23 +408,30 @@ void uiDrawTransform(uiDrawContext *c, uiDrawMatrix *m)
 void uiDrawClip(uiDrawContext *c, uiDrawPath *path)
 {
 	uiprivRunPath(path, c->cr);
-	switch (uiprivPathFillMode(path)) {
-	case uiDrawFillModeWinding:
-		cairo_set_fill_rule(c->cr, CAIRO_FILL_RULE_WINDING);
-		break;
-	case uiDrawFillModeAlternate:
-		cairo_set_fill_rule(c->cr, CAIRO_FILL_RULE_EVEN_ODD);
-		break;
-	}
+	setFillRule(c, fillRule(path));
 	cairo_clip(c->cr);
 }
 
 void uiDrawSave(uiDrawContext *c)
 {
 	cairo_save(c->cr);
+	g_array_append_val(c->savedStates, c->state);
 }
 
 void uiDrawRestore(uiDrawContext *c)
 {
 	cairo_restore(c->cr);
+	// cairo puts back whatever it had at the matching cairo_save(), which is what we had then too
+	// TODO uiprivUserBug() on unbalanced calls instead? cairo just reports an error status
+	if (c->savedStates->len == 0) {
+		memset(&(c->state), 0, sizeof (struct uiprivDrawState));
+		return;
+	}
+	c->state = g_array_index(c->savedStates, struct uiprivDrawState, c->savedStates->len - 1);
+	g_array_set_size(c->savedStates, c->savedStates->len - 1);
+}
+
+void uiDrawContextStats(uiDrawContext *c, uiDrawStats *s)
+{
+	*s = c->stats;
 }
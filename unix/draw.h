@@ -1,13 +1,36 @@
 // 5 may 2016
 
 // draw.c
+// dash arrays longer than this aren't remembered, so they are always sent to cairo
+#define uiprivMaxTrackedDashes 8
+
+// this is the cairo state we last set, so we can avoid setting it again
+// the valid flags are FALSE when we don't know what cairo has, such as at the start of drawing
+struct uiprivDrawState {
+	gboolean strokeValid;
+	cairo_line_cap_t cap;
+	cairo_line_join_t join;
+	double miterLimit;
+	double thickness;
+	double dashes[uiprivMaxTrackedDashes];
+	size_t numDashes;
+	double dashPhase;
+	gboolean fillRuleValid;
+	cairo_fill_rule_t fillRule;
+};
+
 struct uiDrawContext {
 	cairo_t *cr;
 	GtkStyleContext *style;
+	struct uiprivDrawState state;
+	// uiDrawSave() pushes state here and uiDrawRestore() pops it back, as cairo_save() and cairo_restore() do with the real state
+	GArray *savedStates;
+	uiDrawStats stats;
 };
 
 // drawpath.c
 extern void uiprivRunPath(uiDrawPath *p, cairo_t *cr);
+extern void uiprivRunPathAsCompiled(uiDrawPath *p, cairo_t *cr);
 extern uiDrawFillMode uiprivPathFillMode(uiDrawPath *path);
 
 // drawmatrix.c
@@ -0,0 +1,69 @@
+// 18 october 2026
+#include "uipriv_unix.h"
+#include "draw.h"
+
+// cairo image surfaces are entirely in memory, so none of this needs a GdkWindow or even a GdkDisplay
+struct uiDrawImageContext {
+	cairo_surface_t *surface;
+	cairo_t *cr;
+	uiDrawContext *c;
+};
+
+uiDrawImageContext *uiDrawNewImageContext(double width, double height, double scale)
+{
+	uiDrawImageContext *ic;
+
+	if (scale <= 0)
+		uiprivUserBug("You cannot create a uiDrawImageContext with a scale of %g.", scale);
+	ic = uiprivNew(uiDrawImageContext);
+	// CAIRO_FORMAT_ARGB32 is exactly the pixel format uiDrawImageContextPixels() promises
+	ic->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+		(int) ceil(width * scale),
+		(int) ceil(height * scale));
+	if (cairo_surface_status(ic->surface) != CAIRO_STATUS_SUCCESS)
+		uiprivImplBug("error creating uiDrawImageContext surface: %s",
+			cairo_status_to_string(cairo_surface_status(ic->surface)));
+	// new image surfaces are already cleared to transparent
+	ic->cr = cairo_create(ic->surface);
+	// as with layers, the drawing code doesn't need to know about the scale
+	cairo_scale(ic->cr, scale, scale);
+	ic->c = uiprivNewContext(ic->cr, NULL);
+	return ic;
+}
+
+void uiDrawFreeImageContext(uiDrawImageContext *ic)
+{
+	uiprivFreeContext(ic->c);
+	cairo_destroy(ic->cr);
+	cairo_surface_destroy(ic->surface);
+	uiprivFree(ic);
+}
+
+uiDrawContext *uiDrawImageContextContext(uiDrawImageContext *ic)
+{
+	return ic->c;
+}
+
+void uiDrawImageContextClear(uiDrawImageContext *ic)
+{
+	// the operator isn't part of the state uiDrawContext tracks, and cairo_restore() puts it back anyway
+	cairo_save(ic->cr);
+	cairo_set_operator(ic->cr, CAIRO_OPERATOR_CLEAR);
+	cairo_paint(ic->cr);
+	cairo_restore(ic->cr);
+}
+
+const uint8_t *uiDrawImageContextPixels(uiDrawImageContext *ic, int *width, int *height, int *stride)
+{
+	cairo_surface_flush(ic->surface);
+	*width = cairo_image_surface_get_width(ic->surface);
+	*height = cairo_image_surface_get_height(ic->surface);
+	*stride = cairo_image_surface_get_stride(ic->surface);
+	return (const uint8_t *) cairo_image_surface_get_data(ic->surface);
+}
+
+int uiDrawImageContextWritePNG(uiDrawImageContext *ic, const char *filename)
+{
+	cairo_surface_flush(ic->surface);
+	return cairo_surface_write_to_png(ic->surface, filename) == CAIRO_STATUS_SUCCESS;
+}
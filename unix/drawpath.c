@@ -2,203 +2,453 @@
 #include "uipriv_unix.h"
 #include "draw.h"
 
+// paths are stored as one byte per segment plus only as many coordinates as that segment needs, instead of a fixed-size structure per segment
+// plots can easily have paths with millions of lines, so this keeps the memory down and makes walking the path cache-friendly
 struct uiDrawPath {
-	GArray *pieces;
+	GByteArray *verbs;
+	GArray *coords;
+	// these are kept up to date as the path is built; arcs and curves contribute their whole circle and control points, respectively, so this may be larger than the actual shape
+	double x0, y0, x1, y1;
 	uiDrawFillMode fillMode;
 	gboolean ended;
-};
-
-struct piece {
-	int type;
-	double d[8];
-	int b;
+	gboolean hasArcs;
+	// once a path is ended, we convert it to a cairo path once and keep the result around, so drawing is just a cairo_append_path()
+	// compiled always points to the data we draw; without arcs, the data lives in our own array and is reused across uiDrawPathReset()
+	// cairo turns arcs into curves with a precision that depends on the scale of the current transform, so paths with arcs are replayed through cairo instead, and are only valid for the transform class they were compiled for
+	cairo_path_t compiled;
+	GArray *data;
+	cairo_path_t *copied;
+	int compiledClass;
 };
 
 enum {
 	newFigure,
 	newFigureArc,
+	newFigureArcNegative,
 	lineTo,
 	arcTo,
+	arcToNegative,
 	bezierTo,
 	closeFigure,
 	addRect,
 };
 
+static const guint nCoords[] = {
+	[newFigure] = 2,
+	[newFigureArc] = 5,
+	[newFigureArcNegative] = 5,
+	[lineTo] = 2,
+	[arcTo] = 5,
+	[arcToNegative] = 5,
+	[bezierTo] = 6,
+	[closeFigure] = 0,
+	[addRect] = 4,
+};
+
+static void resetBounds(uiDrawPath *p)
+{
+	p->x0 = G_MAXDOUBLE;
+	p->y0 = G_MAXDOUBLE;
+	p->x1 = -G_MAXDOUBLE;
+	p->y1 = -G_MAXDOUBLE;
+}
+
 uiDrawPath *uiDrawNewPath(uiDrawFillMode mode)
 {
 	uiDrawPath *p;
 
 	p = uiprivNew(uiDrawPath);
-	p->pieces = g_array_new(FALSE, TRUE, sizeof (struct piece));
+	p->verbs = g_byte_array_new();
+	p->coords = g_array_new(FALSE, FALSE, sizeof (double));
+	p->data = g_array_new(FALSE, FALSE, sizeof (cairo_path_data_t));
+	resetBounds(p);
 	p->fillMode = mode;
 	return p;
 }
 
+static void freeCompiled(uiDrawPath *p)
+{
+	if (p->copied != NULL)
+		cairo_path_destroy(p->copied);
+	p->copied = NULL;
+	g_array_set_size(p->data, 0);
+	p->compiled.data = NULL;
+	p->compiled.num_data = 0;
+}
+
 void uiDrawFreePath(uiDrawPath *p)
 {
-	g_array_free(p->pieces, TRUE);
+	freeCompiled(p);
+	g_array_free(p->data, TRUE);
+	g_array_free(p->coords, TRUE);
+	g_byte_array_free(p->verbs, TRUE);
 	uiprivFree(p);
 }
 
-static void add(uiDrawPath *p, struct piece *piece)
+void uiDrawPathReset(uiDrawPath *p)
+{
+	// this keeps the memory of the arrays around for the next time the path is built
+	g_byte_array_set_size(p->verbs, 0);
+	g_array_set_size(p->coords, 0);
+	freeCompiled(p);
+	resetBounds(p);
+	p->hasArcs = FALSE;
+	p->ended = FALSE;
+}
+
+static void add(uiDrawPath *p, guint8 verb, const double *d)
 {
 	if (p->ended)
 		uiprivUserBug("You cannot modify a uiDrawPath that has been ended. (path: %p)", p);
-	g_array_append_vals(p->pieces, piece, 1);
+	g_byte_array_append(p->verbs, &verb, 1);
+	g_array_append_vals(p->coords, d, nCoords[verb]);
+}
+
+static void addBounds(uiDrawPath *p, double x, double y)
+{
+	if (x < p->x0)
+		p->x0 = x;
+	if (x > p->x1)
+		p->x1 = x;
+	if (y < p->y0)
+		p->y0 = y;
+	if (y > p->y1)
+		p->y1 = y;
 }
 
 void uiDrawPathNewFigure(uiDrawPath *p, double x, double y)
 {
-	struct piece piece;
+	double d[2];
 
-	piece.type = newFigure;
-	piece.d[0] = x;
-	piece.d[1] = y;
-	add(p, &piece);
+	d[0] = x;
+	d[1] = y;
+	add(p, newFigure, d);
+	addBounds(p, x, y);
 }
 
-void uiDrawPathNewFigureWithArc(uiDrawPath *p, double xCenter, double yCenter, double radius, double startAngle, double sweep, int negative)
+static void addArc(uiDrawPath *p, guint8 verb, double xCenter, double yCenter, double radius, double startAngle, double sweep)
 {
-	struct piece piece;
+	double d[5];
 
 	if (sweep > 2 * uiPi)
 		sweep = 2 * uiPi;
-	piece.type = newFigureArc;
-	piece.d[0] = xCenter;
-	piece.d[1] = yCenter;
-	piece.d[2] = radius;
-	piece.d[3] = startAngle;
-	piece.d[4] = sweep;
-	piece.b = negative;
-	add(p, &piece);
+	d[0] = xCenter;
+	d[1] = yCenter;
+	d[2] = radius;
+	d[3] = startAngle;
+	d[4] = sweep;
+	add(p, verb, d);
+	p->hasArcs = TRUE;
+	addBounds(p, xCenter - radius, yCenter - radius);
+	addBounds(p, xCenter + radius, yCenter + radius);
+}
+
+void uiDrawPathNewFigureWithArc(uiDrawPath *p, double xCenter, double yCenter, double radius, double startAngle, double sweep, int negative)
+{
+	addArc(p, negative ? newFigureArcNegative : newFigureArc,
+		xCenter, yCenter, radius, startAngle, sweep);
 }
 
 void uiDrawPathLineTo(uiDrawPath *p, double x, double y)
 {
-	struct piece piece;
+	double d[2];
 
-	piece.type = lineTo;
-	piece.d[0] = x;
-	piece.d[1] = y;
-	add(p, &piece);
+	d[0] = x;
+	d[1] = y;
+	add(p, lineTo, d);
+	addBounds(p, x, y);
 }
 
 void uiDrawPathArcTo(uiDrawPath *p, double xCenter, double yCenter, double radius, double startAngle, double sweep, int negative)
 {
-	struct piece piece;
-
-	if (sweep > 2 * uiPi)
-		sweep = 2 * uiPi;
-	piece.type = arcTo;
-	piece.d[0] = xCenter;
-	piece.d[1] = yCenter;
-	piece.d[2] = radius;
-	piece.d[3] = startAngle;
-	piece.d[4] = sweep;
-	piece.b = negative;
-	add(p, &piece);
+	addArc(p, negative ? arcToNegative : arcTo,
+		xCenter, yCenter, radius, startAngle, sweep);
 }
 
 void uiDrawPathBezierTo(uiDrawPath *p, double c1x, double c1y, double c2x, double c2y, double endX, double endY)
 {
-	struct piece piece;
+	double d[6];
 
-	piece.type = bezierTo;
-	piece.d[0] = c1x;
-	piece.d[1] = c1y;
-	piece.d[2] = c2x;
-	piece.d[3] = c2y;
-	piece.d[4] = endX;
-	piece.d[5] = endY;
-	add(p, &piece);
+	d[0] = c1x;
+	d[1] = c1y;
+	d[2] = c2x;
+	d[3] = c2y;
+	d[4] = endX;
+	d[5] = endY;
+	add(p, bezierTo, d);
+	// a bezier curve always lies within the hull of its control points
+	addBounds(p, c1x, c1y);
+	addBounds(p, c2x, c2y);
+	addBounds(p, endX, endY);
 }
 
 void uiDrawPathCloseFigure(uiDrawPath *p)
 {
-	struct piece piece;
-
-	piece.type = closeFigure;
-	add(p, &piece);
+	add(p, closeFigure, NULL);
 }
 
 void uiDrawPathAddRectangle(uiDrawPath *p, double x, double y, double width, double height)
 {
-	struct piece piece;
+	double d[4];
 
-	piece.type = addRect;
-	piece.d[0] = x;
-	piece.d[1] = y;
-	piece.d[2] = width;
-	piece.d[3] = height;
-	add(p, &piece);
+	d[0] = x;
+	d[1] = y;
+	d[2] = width;
+	d[3] = height;
+	add(p, addRect, d);
+	addBounds(p, x, y);
+	addBounds(p, x + width, y + height);
 }
 
-void uiDrawPathEnd(uiDrawPath *p)
+void uiDrawPathAddPolyline(uiDrawPath *p, const double *xy, size_t n)
 {
-	p->ended = TRUE;
-}
+	guint len;
+	size_t i;
 
-int uiDrawPathEnded(uiDrawPath *p)
-{
-	return p->ended == TRUE ? 1 : 0;
+	if (n == 0)
+		return;
+	uiDrawPathNewFigure(p, xy[0], xy[1]);
+	n--;
+	xy += 2;
+	len = p->verbs->len;
+	g_byte_array_set_size(p->verbs, len + n);
+	memset(p->verbs->data + len, lineTo, n);
+	// the coordinates of a run of lineTos are laid out exactly like xy, so we can copy them as is
+	g_array_append_vals(p->coords, xy, 2 * n);
+	for (i = 0; i < 2 * n; i += 2)
+		addBounds(p, xy[i], xy[i + 1]);
 }
 
-void uiprivRunPath(uiDrawPath *p, cairo_t *cr)
+static void runPieces(uiDrawPath *p, cairo_t *cr)
 {
 	guint i;
-	struct piece *piece;
-	void (*arc)(cairo_t *, double, double, double, double, double);
+	const double *d;
 
-	if (!p->ended)
-		uiprivUserBug("You cannot draw with a uiDrawPath that has not been ended. (path: %p)", p);
 	cairo_new_path(cr);
-	for (i = 0; i < p->pieces->len; i++) {
-		piece = &g_array_index(p->pieces, struct piece, i);
-		switch (piece->type) {
+	d = (const double *) (p->coords->data);
+	for (i = 0; i < p->verbs->len; i++) {
+		switch (p->verbs->data[i]) {
 		case newFigure:
-			cairo_move_to(cr, piece->d[0], piece->d[1]);
+			cairo_move_to(cr, d[0], d[1]);
 			break;
 		case newFigureArc:
 			cairo_new_sub_path(cr);
 			// fall through
 		case arcTo:
-			arc = cairo_arc;
-			if (piece->b)
-				arc = cairo_arc_negative;
-			(*arc)(cr,
-				piece->d[0],
-				piece->d[1],
-				piece->d[2],
-				piece->d[3],
-				piece->d[3] + piece->d[4]);
+			cairo_arc(cr, d[0], d[1], d[2], d[3], d[3] + d[4]);
+			break;
+		case newFigureArcNegative:
+			cairo_new_sub_path(cr);
+			// fall through
+		case arcToNegative:
+			cairo_arc_negative(cr, d[0], d[1], d[2], d[3], d[3] + d[4]);
 			break;
 		case lineTo:
-			cairo_line_to(cr, piece->d[0], piece->d[1]);
+			cairo_line_to(cr, d[0], d[1]);
 			break;
 		case bezierTo:
-			cairo_curve_to(cr,
-				piece->d[0],
-				piece->d[1],
-				piece->d[2],
-				piece->d[3],
-				piece->d[4],
-				piece->d[5]);
+			cairo_curve_to(cr, d[0], d[1], d[2], d[3], d[4], d[5]);
 			break;
 		case closeFigure:
 			cairo_close_path(cr);
 			break;
 		case addRect:
-			cairo_rectangle(cr,
-				piece->d[0],
-				piece->d[1],
-				piece->d[2],
-				piece->d[3]);
+			cairo_rectangle(cr, d[0], d[1], d[2], d[3]);
+			break;
+		}
+		d += nCoords[p->verbs->data[i]];
+	}
+}
+
+// transforms whose scales are within a factor of two of each other are in the same class; that's close enough for cairo's arc tolerance
+// TODO take the device scale of HiDPI surfaces into account too
+static int transformClass(const cairo_matrix_t *m)
+{
+	double sx, sy;
+
+	sx = hypot(m->xx, m->yx);
+	sy = hypot(m->xy, m->yy);
+	if (sy > sx)
+		sx = sy;
+	if (sx <= 0)
+		return 0;
+	return (int) floor(log2(sx));
+}
+
+static void compileArcs(uiDrawPath *p, const cairo_matrix_t *ctm)
+{
+	cairo_surface_t *scratch;
+	cairo_t *cr;
+	cairo_matrix_t m;
+
+	freeCompiled(p);
+	scratch = cairo_image_surface_create(CAIRO_FORMAT_A8, 0, 0);
+	cr = cairo_create(scratch);
+	// only the scale matters for arcs, and cairo_copy_path() gives us back user-space coordinates, so drop the translation
+	m = *ctm;
+	m.x0 = 0;
+	m.y0 = 0;
+	cairo_set_matrix(cr, &m);
+	runPieces(p, cr);
+	p->copied = cairo_copy_path(cr);
+	if (p->copied->status != CAIRO_STATUS_SUCCESS)
+		uiprivImplBug("error compiling uiDrawPath %p: %s", p,
+			cairo_status_to_string(p->copied->status));
+	p->compiled = *(p->copied);
+	p->compiledClass = transformClass(&m);
+	cairo_destroy(cr);
+	cairo_surface_destroy(scratch);
+}
+
+#define setHeader(pd, t, n) ((pd)->header.type = (t), (pd)->header.length = (n))
+#define setPoint(pd, px, py) ((pd)->point.x = (px), (pd)->point.y = (py))
+
+// without arcs, there is nothing for cairo to approximate, so we can write the cairo path data ourselves and skip replaying through a scratch context
+// cairo_append_path() feeds the data through the same functions runPieces() uses, so the result is the same
+static void compileFlat(uiDrawPath *p)
+{
+	guint i, n;
+	const double *d;
+	cairo_path_data_t *pd;
+
+	freeCompiled(p);
+	n = 0;
+	for (i = 0; i < p->verbs->len; i++)
+		switch (p->verbs->data[i]) {
+		case newFigure:
+		case lineTo:
+			n += 2;
+			break;
+		case bezierTo:
+			n += 4;
+			break;
+		case closeFigure:
+			n += 1;
+			break;
+		case addRect:
+			// this is what cairo_rectangle() produces
+			n += 2 + 2 + 2 + 2 + 1;
+			break;
+		}
+	g_array_set_size(p->data, n);
+	pd = (cairo_path_data_t *) (p->data->data);
+	d = (const double *) (p->coords->data);
+	for (i = 0; i < p->verbs->len; i++) {
+		switch (p->verbs->data[i]) {
+		case newFigure:
+			setHeader(pd, CAIRO_PATH_MOVE_TO, 2);
+			setPoint(pd + 1, d[0], d[1]);
+			pd += 2;
+			break;
+		case lineTo:
+			setHeader(pd, CAIRO_PATH_LINE_TO, 2);
+			setPoint(pd + 1, d[0], d[1]);
+			pd += 2;
+			break;
+		case bezierTo:
+			setHeader(pd, CAIRO_PATH_CURVE_TO, 4);
+			setPoint(pd + 1, d[0], d[1]);
+			setPoint(pd + 2, d[2], d[3]);
+			setPoint(pd + 3, d[4], d[5]);
+			pd += 4;
+			break;
+		case closeFigure:
+			setHeader(pd, CAIRO_PATH_CLOSE_PATH, 1);
+			pd += 1;
+			break;
+		case addRect:
+			setHeader(pd, CAIRO_PATH_MOVE_TO, 2);
+			setPoint(pd + 1, d[0], d[1]);
+			setHeader(pd + 2, CAIRO_PATH_LINE_TO, 2);
+			setPoint(pd + 3, d[0] + d[2], d[1]);
+			setHeader(pd + 4, CAIRO_PATH_LINE_TO, 2);
+			setPoint(pd + 5, d[0] + d[2], d[1] + d[3]);
+			setHeader(pd + 6, CAIRO_PATH_LINE_TO, 2);
+			setPoint(pd + 7, d[0], d[1] + d[3]);
+			setHeader(pd + 8, CAIRO_PATH_CLOSE_PATH, 1);
+			pd += 9;
 			break;
 		}
+		d += nCoords[p->verbs->data[i]];
+	}
+	p->compiled.status = CAIRO_STATUS_SUCCESS;
+	p->compiled.data = (cairo_path_data_t *) (p->data->data);
+	p->compiled.num_data = n;
+}
+
+void uiDrawPathEnd(uiDrawPath *p)
+{
+	cairo_matrix_t identity;
+
+	p->ended = TRUE;
+	if (!p->hasArcs) {
+		compileFlat(p);
+		return;
+	}
+	// most paths are drawn without a scale; if not, we'll recompile the first time we draw
+	cairo_matrix_init_identity(&identity);
+	compileArcs(p, &identity);
+}
+
+int uiDrawPathEnded(uiDrawPath *p)
+{
+	return p->ended == TRUE ? 1 : 0;
+}
+
+// tiled uiAreas can draw the same path on several threads at once, and recompiling replaces the compiled data out from under anyone else using it
+// paths without arcs never change after uiDrawPathEnd(), so they don't need this
+static GMutex arcsLock;
+
+static void runPath(uiDrawPath *p, cairo_t *cr, gboolean recompile)
+{
+	cairo_matrix_t ctm;
+
+	if (!p->ended)
+		uiprivUserBug("You cannot draw with a uiDrawPath that has not been ended. (path: %p)", p);
+	if (!p->hasArcs) {
+		cairo_new_path(cr);
+		cairo_append_path(cr, &(p->compiled));
+		return;
+	}
+	g_mutex_lock(&arcsLock);
+	cairo_get_matrix(cr, &ctm);
+	// cairo_set_matrix() won't take a matrix that can't be inverted, and nothing would be drawn with it anyway
+	if (recompile && cairo_matrix_invert(&ctm) == CAIRO_STATUS_SUCCESS) {
+		cairo_get_matrix(cr, &ctm);
+		if (transformClass(&ctm) != p->compiledClass)
+			compileArcs(p, &ctm);
 	}
+	cairo_new_path(cr);
+	cairo_append_path(cr, &(p->compiled));
+	g_mutex_unlock(&arcsLock);
+}
+
+void uiprivRunPath(uiDrawPath *p, cairo_t *cr)
+{
+	runPath(p, cr, TRUE);
+}
+
+// the compiled path is in user space whatever transform class it was compiled for; only how finely the arcs were flattened differs, which doesn't matter for hit-testing
+// so use it as is, instead of recompiling now and again the next time the path is drawn under its usual transform
+void uiprivRunPathAsCompiled(uiDrawPath *p, cairo_t *cr)
+{
+	runPath(p, cr, FALSE);
 }
 
 uiDrawFillMode uiprivPathFillMode(uiDrawPath *path)
 {
 	return path->fillMode;
 }
+
+int uiDrawPathBounds(uiDrawPath *path, double *x, double *y, double *width, double *height)
+{
+	if (!path->ended)
+		uiprivUserBug("You cannot call uiDrawPathBounds() on a uiDrawPath that has not been ended. (path: %p)", path);
+	if (path->x1 < path->x0)
+		return 0;
+	*x = path->x0;
+	*y = path->y0;
+	*width = path->x1 - path->x0;
+	*height = path->y1 - path->y0;
+	return 1;
+}
@@ -0,0 +1,71 @@
+// 18 october 2026
+#include "uipriv_unix.h"
+#include "draw.h"
+
+// cairo draws straight from the surface's memory, so handing that memory out is all it takes to avoid copying
+struct uiDrawPixelBuffer {
+	cairo_surface_t *surface;
+	gboolean writing;
+};
+
+uiDrawPixelBuffer *uiDrawNewPixelBuffer(int width, int height)
+{
+	uiDrawPixelBuffer *pb;
+
+	if (width <= 0 || height <= 0)
+		uiprivUserBug("You cannot create a uiDrawPixelBuffer of size %dx%d.", width, height);
+	pb = uiprivNew(uiDrawPixelBuffer);
+	pb->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+	if (cairo_surface_status(pb->surface) != CAIRO_STATUS_SUCCESS)
+		uiprivImplBug("error creating uiDrawPixelBuffer surface: %s",
+			cairo_status_to_string(cairo_surface_status(pb->surface)));
+	return pb;
+}
+
+void uiDrawFreePixelBuffer(uiDrawPixelBuffer *pb)
+{
+	cairo_surface_destroy(pb->surface);
+	uiprivFree(pb);
+}
+
+uint8_t *uiDrawPixelBufferBegin(uiDrawPixelBuffer *pb, int *stride)
+{
+	if (pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferBegin() on a uiDrawPixelBuffer that is already being written to. (pixel buffer: %p)", pb);
+	pb->writing = TRUE;
+	// cairo requires this before touching the memory of a surface ourselves
+	cairo_surface_flush(pb->surface);
+	*stride = cairo_image_surface_get_stride(pb->surface);
+	return cairo_image_surface_get_data(pb->surface);
+}
+
+void uiDrawPixelBufferEnd(uiDrawPixelBuffer *pb, int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight)
+{
+	if (!pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferEnd() without first calling uiDrawPixelBufferBegin(). (pixel buffer: %p)", pb);
+	pb->writing = FALSE;
+	// and this tells cairo to forget anything it cached about those pixels
+	cairo_surface_mark_dirty_rectangle(pb->surface, dirtyX, dirtyY, dirtyWidth, dirtyHeight);
+}
+
+void uiDrawPixels(uiDrawContext *c, uiDrawPixelBuffer *pb, double x, double y, double width, double height)
+{
+	if (pb->writing)
+		uiprivUserBug("You cannot draw a uiDrawPixelBuffer that is being written to. (pixel buffer: %p)", pb);
+	// a scale of 0 can't be inverted, which would put c->cr into an error state that cairo_restore() doesn't clear
+	if (width <= 0 || height <= 0)
+		return;
+	// as with uiDrawLayer(), cairo_restore() puts back everything this changes
+	cairo_save(c->cr);
+	cairo_rectangle(c->cr, x, y, width, height);
+	cairo_clip(c->cr);
+	cairo_translate(c->cr, x, y);
+	cairo_scale(c->cr,
+		width / cairo_image_surface_get_width(pb->surface),
+		height / cairo_image_surface_get_height(pb->surface));
+	cairo_set_source_surface(c->cr, pb->surface, 0, 0);
+	// without this, cairo fades the edges of the buffer into transparency when stretching it
+	cairo_pattern_set_extend(cairo_get_source(c->cr), CAIRO_EXTEND_PAD);
+	cairo_paint(c->cr);
+	cairo_restore(c->cr);
+}
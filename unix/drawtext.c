@@ -5,6 +5,8 @@
 
 struct uiDrawTextLayout {
 	PangoLayout *layout;
+	// only for layouts made by uiDrawNewTextLayoutAsync(); see below
+	PangoFontMap *fontmap;
 };
 
 // we need a context for a few things
@@ -19,13 +21,32 @@ static const PangoAlignment pangoAligns[] = {
 	[uiDrawTextAlignRight] = PANGO_ALIGN_RIGHT,
 };
 
+// this is shared between the synchronous and asynchronous paths, so it must not touch anything libui-specific
+static void initLayout(PangoLayout *layout, const char *text, const PangoFontDescription *desc, double width, uiDrawTextAlign align, PangoAttrList *attrs)
+{
+	int pangoWidth;
+
+	// this is safe; pango_layout_set_text() copies the string
+	pango_layout_set_text(layout, text, -1);
+
+	// this is safe; the description is copied
+	pango_layout_set_font_description(layout, desc);
+
+	pangoWidth = cairoToPango(width);
+	if (width < 0)
+		pangoWidth = -1;
+	pango_layout_set_width(layout, pangoWidth);
+
+	pango_layout_set_alignment(layout, pangoAligns[align]);
+
+	pango_layout_set_attributes(layout, attrs);
+}
+
 uiDrawTextLayout *uiDrawNewTextLayout(uiDrawTextLayoutParams *p)
 {
 	uiDrawTextLayout *tl;
 	PangoContext *context;
-	PangoFontDescription *desc;
 	PangoAttrList *attrs;
-	int pangoWidth;
 
 	tl = uiprivNew(uiDrawTextLayout);
 
@@ -35,31 +56,184 @@ uiDrawTextLayout *uiDrawNewTextLayout(uiDrawTextLayoutParams *p)
 	tl->layout = pango_layout_new(context);
 	g_object_unref(context);
 
-	// this is safe; pango_layout_set_text() copies the string
-	pango_layout_set_text(tl->layout, uiAttributedStringString(p->String), -1);
+	attrs = uiprivAttributedStringToPangoAttrList(p);
+	initLayout(tl->layout,
+		uiAttributedStringString(p->String),
+		uiprivCachedPangoFontDescription(p->DefaultFont),
+		p->Width, p->Align, attrs);
+	pango_attr_list_unref(attrs);
 
-	desc = uiprivFontDescriptorToPangoFontDescription(p->DefaultFont);
-	pango_layout_set_font_description(tl->layout, desc);
-	// this is safe; the description is copied
-	pango_font_description_free(desc);
+	return tl;
+}
 
-	pangoWidth = cairoToPango(p->Width);
-	if (p->Width < 0)
-		pangoWidth = -1;
-	pango_layout_set_width(tl->layout, pangoWidth);
+// for asynchronous layouts, we snapshot everything we need from the uiAttributedString on the main thread and do the actual shaping on a worker thread
+// uiprivAlloc() is only safe on the main thread, so both the uiDrawTextLayout and this structure are allocated here and freed there
+struct asyncLayout {
+	uiDrawTextLayout *tl;
+	char *text;
+	PangoFontDescription *desc;
+	PangoAttrList *attrs;
+	double width;
+	uiDrawTextAlign align;
+	cairo_font_options_t *fontOptions;
+	double resolution;
+	void (*f)(uiDrawTextLayout *tl, void *data);
+	void *data;
+	// set by the worker thread; see uiprivUninitDrawText()
+	guint idle;
+};
 
-	pango_layout_set_alignment(tl->layout, pangoAligns[p->Align]);
+static GThreadPool *asyncLayoutPool = NULL;
+// every asyncLayout whose f hasn't been called yet; only touched on the main thread
+static GPtrArray *asyncLayouts = NULL;
+// the idle callback can run before gdk_threads_add_idle() even returns, so hold this until idle is set
+static GMutex asyncLayoutIdleLock;
 
-	attrs = uiprivAttributedStringToPangoAttrList(p);
-	pango_layout_set_attributes(tl->layout, attrs);
-	pango_attr_list_unref(attrs);
+// font maps are not thread-safe, and a finished layout is drawn on the main thread while the workers go on shaping others
+// so every asynchronous layout gets a font map that nothing else uses for as long as the layout is alive
+// making a new font map each time would mean resolving every font through fontconfig again, so when a layout is freed, its font map goes back here for the next one
+// the lock is only held to take a font map out or put one back, never while shaping or drawing
+static GMutex idleFontMapsLock;
+static GQueue idleFontMaps = G_QUEUE_INIT;
 
-	return tl;
+static PangoFontMap *takeFontMap(void)
+{
+	PangoFontMap *fontmap;
+
+	g_mutex_lock(&idleFontMapsLock);
+	fontmap = (PangoFontMap *) g_queue_pop_head(&idleFontMaps);
+	g_mutex_unlock(&idleFontMapsLock);
+	if (fontmap == NULL)
+		fontmap = pango_cairo_font_map_new();
+	return fontmap;
+}
+
+// this takes ownership of fontmap
+// there's no point in keeping more font maps around than there are workers to use them
+static void returnFontMap(PangoFontMap *fontmap)
+{
+	g_mutex_lock(&idleFontMapsLock);
+	if (g_queue_get_length(&idleFontMaps) < g_get_num_processors()) {
+		g_queue_push_head(&idleFontMaps, fontmap);
+		fontmap = NULL;
+	}
+	g_mutex_unlock(&idleFontMapsLock);
+	if (fontmap != NULL)
+		g_object_unref(fontmap);
+}
+
+// PangoLayouts fill in their lines lazily and aren't thread-safe, but tiled uiAreas can draw the same layout on several threads at once
+static GMutex drawTextLock;
+
+static gboolean asyncLayoutDone(gpointer data)
+{
+	struct asyncLayout *al = (struct asyncLayout *) data;
+
+	g_mutex_lock(&asyncLayoutIdleLock);
+	g_mutex_unlock(&asyncLayoutIdleLock);
+	g_ptr_array_remove_fast(asyncLayouts, al);
+	(*(al->f))(al->tl, al->data);
+	uiprivFree(al);
+	return FALSE;
+}
+
+static void asyncLayoutWork(gpointer data, gpointer userData)
+{
+	struct asyncLayout *al = (struct asyncLayout *) data;
+	PangoFontMap *fontmap;
+	PangoContext *context;
+	PangoRectangle logical;
+
+	fontmap = takeFontMap();
+	al->tl->fontmap = fontmap;
+	context = pango_font_map_create_context(fontmap);
+	// match the settings of mkGenericPangoCairoContext() so the results are the same as with uiDrawNewTextLayout()
+	if (al->fontOptions != NULL)
+		pango_cairo_context_set_font_options(context, al->fontOptions);
+	pango_cairo_context_set_resolution(context, al->resolution);
+	al->tl->layout = pango_layout_new(context);
+	g_object_unref(context);
+
+	initLayout(al->tl->layout, al->text, al->desc, al->width, al->align, al->attrs);
+	// this is what actually itemizes and shapes the text
+	pango_layout_get_extents(al->tl->layout, NULL, &logical);
+
+	g_free(al->text);
+	pango_font_description_free(al->desc);
+	pango_attr_list_unref(al->attrs);
+	if (al->fontOptions != NULL)
+		cairo_font_options_destroy(al->fontOptions);
+	g_mutex_lock(&asyncLayoutIdleLock);
+	al->idle = gdk_threads_add_idle(asyncLayoutDone, al);
+	g_mutex_unlock(&asyncLayoutIdleLock);
+}
+
+void uiDrawNewTextLayoutAsync(uiDrawTextLayoutParams *p, void (*f)(uiDrawTextLayout *tl, void *data), void *data)
+{
+	struct asyncLayout *al;
+	PangoContext *context;
+	const cairo_font_options_t *fontOptions;
+	GError *err = NULL;
+
+	if (asyncLayoutPool == NULL) {
+		asyncLayoutPool = g_thread_pool_new(asyncLayoutWork, NULL,
+			g_get_num_processors(), FALSE, &err);
+		if (asyncLayoutPool == NULL)
+			uiprivImplBug("error creating text layout thread pool: %s", err->message);
+		asyncLayouts = g_ptr_array_new();
+	}
+
+	al = uiprivNew(struct asyncLayout);
+	al->tl = uiprivNew(uiDrawTextLayout);
+	al->text = g_strdup(uiAttributedStringString(p->String));
+	al->desc = pango_font_description_copy(uiprivCachedPangoFontDescription(p->DefaultFont));
+	al->attrs = uiprivAttributedStringToPangoAttrList(p);
+	al->width = p->Width;
+	al->align = p->Align;
+	context = mkGenericPangoCairoContext();
+	fontOptions = pango_cairo_context_get_font_options(context);
+	if (fontOptions != NULL)
+		al->fontOptions = cairo_font_options_copy(fontOptions);
+	al->resolution = pango_cairo_context_get_resolution(context);
+	g_object_unref(context);
+	al->f = f;
+	al->data = data;
+
+	g_ptr_array_add(asyncLayouts, al);
+	g_thread_pool_push(asyncLayoutPool, al, NULL);
+}
+
+void uiprivUninitDrawText(void)
+{
+	struct asyncLayout *al;
+	guint i;
+
+	if (asyncLayoutPool == NULL)
+		return;
+	// wait for any layouts in progress to finish
+	g_thread_pool_free(asyncLayoutPool, FALSE, TRUE);
+	asyncLayoutPool = NULL;
+	// every layout that's left is finished but its idle callback hasn't run yet, and now it never will
+	// there's no one to hand them to at this point, so just free them
+	for (i = 0; i < asyncLayouts->len; i++) {
+		al = (struct asyncLayout *) g_ptr_array_index(asyncLayouts, i);
+		g_source_remove(al->idle);
+		uiDrawFreeTextLayout(al->tl);
+		uiprivFree(al);
+	}
+	g_ptr_array_free(asyncLayouts, TRUE);
+	asyncLayouts = NULL;
+	// layouts the program still has keep their own font maps
+	while (!g_queue_is_empty(&idleFontMaps))
+		g_object_unref(g_queue_pop_head(&idleFontMaps));
 }
 
 void uiDrawFreeTextLayout(uiDrawTextLayout *tl)
 {
 	g_object_unref(tl->layout);
+	// the layout is gone, so nothing else is using its font map now
+	if (tl->fontmap != NULL)
+		returnFontMap(tl->fontmap);
 	uiprivFree(tl);
 }
 
@@ -68,7 +242,9 @@ void uiDrawText(uiDrawContext *c, uiDrawTextLayout *tl, double x, double y)
 	// TODO have an implicit save/restore on each drawing functions instead? and is this correct?
 	cairo_set_source_rgb(c->cr, 0.0, 0.0, 0.0);
 	cairo_move_to(c->cr, x, y);
+	g_mutex_lock(&drawTextLock);
 	pango_cairo_show_layout(c->cr, tl->layout);
+	g_mutex_unlock(&drawTextLock);
 }
 
 void uiDrawTextLayoutExtents(uiDrawTextLayout *tl, double *width, double *height)
@@ -80,6 +256,37 @@ void uiDrawTextLayoutExtents(uiDrawTextLayout *tl, double *width, double *height
 	*height = pangoToCairo(logical.height);
 }
 
+// this is equivalent to making a uiDrawTextLayout for each string, but we only need one PangoLayout for the whole batch
+// plain strings have no attributes, so we can skip building a PangoAttrList too
+void uiDrawMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights)
+{
+	PangoContext *context;
+	PangoLayout *layout;
+	PangoRectangle logical;
+	size_t i;
+
+	context = mkGenericPangoCairoContext();
+	layout = pango_layout_new(context);
+	g_object_unref(context);
+
+	pango_layout_set_font_description(layout,
+		uiprivCachedPangoFontDescription(desc));
+
+	// a width of -1 is the default, which is what we want
+	pango_layout_set_alignment(layout, pangoAligns[uiDrawTextAlignLeft]);
+
+	for (i = 0; i < n; i++) {
+		pango_layout_set_text(layout, strings[i], -1);
+		pango_layout_get_extents(layout, NULL, &logical);
+		if (widths != NULL)
+			widths[i] = pangoToCairo(logical.width);
+		if (heights != NULL)
+			heights[i] = pangoToCairo(logical.height);
+	}
+
+	g_object_unref(layout);
+}
+
 void uiLoadControlFont(uiFontDescriptor *f)
 {
 	GtkWidget *widget;
@@ -96,6 +303,26 @@ void uiLoadControlFont(uiFontDescriptor *f)
 	g_object_unref(widget);
 }
 
+void uiFontMetrics(const uiFontDescriptor *desc, double *ascent, double *descent, double *lineHeight, double *avgCharWidth)
+{
+	PangoFontMetrics *metrics;
+	int pascent, pdescent;
+
+	// this is owned by the font cache; don't unref it
+	metrics = uiprivCachedPangoFontMetrics(desc);
+	pascent = pango_font_metrics_get_ascent(metrics);
+	pdescent = pango_font_metrics_get_descent(metrics);
+	if (ascent != NULL)
+		*ascent = pangoToCairo(pascent);
+	if (descent != NULL)
+		*descent = pangoToCairo(pdescent);
+	// this matches the logical height of a single line of a PangoLayout with no spacing
+	if (lineHeight != NULL)
+		*lineHeight = pangoToCairo(pascent + pdescent);
+	if (avgCharWidth != NULL)
+		*avgCharWidth = pangoToCairo(pango_font_metrics_get_approximate_char_width(metrics));
+}
+
 void uiFreeFontDescriptor(uiFontDescriptor *desc)
 {
 	// TODO ensure this is synchronized with fontmatch.c
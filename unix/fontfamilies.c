@@ -0,0 +1,99 @@
+// 18 october 2026
+#include "uipriv_unix.h"
+
+// pango_font_map_list_families() has to go through every font on the system, which is a visible stall when thousands of fonts are installed
+// so we do it once and keep the names around until GTK+ tells us fontconfig's configuration changed
+// the list can also be filled in by the font warm-up thread (see fontwarmup.c), hence the lock
+
+static GMutex familiesLock;
+static GPtrArray *families = NULL;
+static gulong fontconfigChangedHandler = 0;
+
+GPtrArray *uiprivNewFontFamilyList(PangoFontFamily **pfamilies, int n)
+{
+	GPtrArray *list;
+	int i;
+
+	list = g_ptr_array_new_full(n, g_free);
+	for (i = 0; i < n; i++)
+		g_ptr_array_add(list, g_strdup(pango_font_family_get_name(pfamilies[i])));
+	return list;
+}
+
+// this takes ownership of list
+// if a list is already cached, it's kept and list is thrown away
+void uiprivSetFontFamilyList(GPtrArray *list)
+{
+	g_mutex_lock(&familiesLock);
+	if (families == NULL) {
+		families = list;
+		list = NULL;
+	}
+	g_mutex_unlock(&familiesLock);
+	if (list != NULL)
+		g_ptr_array_unref(list);
+}
+
+static void invalidateFontFamilies(void)
+{
+	GPtrArray *old;
+
+	g_mutex_lock(&familiesLock);
+	old = families;
+	families = NULL;
+	g_mutex_unlock(&familiesLock);
+	// anyone still enumerating the old list holds a reference to it
+	if (old != NULL)
+		g_ptr_array_unref(old);
+}
+
+static void fontconfigChanged(GObject *obj, GParamSpec *pspec, gpointer data)
+{
+	invalidateFontFamilies();
+}
+
+// the list can be filled before the first uiListFontFamilies() (see above), so watch for changes from the start
+void uiprivInitFontFamilies(void)
+{
+	// GTK+ reloads fontconfig and bumps this setting whenever the installed fonts change
+	fontconfigChangedHandler = g_signal_connect(gtk_settings_get_default(), "notify::gtk-fontconfig-timestamp",
+		G_CALLBACK(fontconfigChanged), NULL);
+}
+
+void uiListFontFamilies(uiListFontFamiliesFunc f, void *data)
+{
+	GPtrArray *list;
+	PangoFontFamily **pfamilies;
+	int n;
+	guint i;
+
+	g_mutex_lock(&familiesLock);
+	list = families;
+	if (list != NULL)
+		g_ptr_array_ref(list);
+	g_mutex_unlock(&familiesLock);
+
+	if (list == NULL) {
+		pango_font_map_list_families(pango_cairo_font_map_get_default(), &pfamilies, &n);
+		list = uiprivNewFontFamilyList(pfamilies, n);
+		g_free(pfamilies);
+		// one reference for the cache, one for us
+		g_ptr_array_ref(list);
+		uiprivSetFontFamilyList(list);
+	}
+
+	// don't hold the lock while calling f, in case f calls us again
+	for (i = 0; i < list->len; i++)
+		if ((*f)((const char *) g_ptr_array_index(list, i), data) == uiForEachStop)
+			break;
+	g_ptr_array_unref(list);
+}
+
+void uiprivUninitFontFamilies(void)
+{
+	if (fontconfigChangedHandler != 0) {
+		g_signal_handler_disconnect(gtk_settings_get_default(), fontconfigChangedHandler);
+		fontconfigChangedHandler = 0;
+	}
+	invalidateFontFamilies();
+}
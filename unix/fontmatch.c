@@ -54,6 +54,129 @@ PangoFontDescription *uiprivFontDescriptorToPangoFontDescription(const uiFontDes
 	return desc;
 }
 
+// resolving a font through fontconfig is expensive, so we keep the PangoFontDescription, PangoFont, and PangoFontMetrics for every uiFontDescriptor value we've seen
+// the font and metrics are only loaded when first asked for
+struct fontCacheEntry {
+	uiFontDescriptor key;		// must be first; Family is owned by the entry
+	PangoFontDescription *desc;
+	PangoFont *font;
+	PangoFontMetrics *metrics;
+};
+
+// most programs only ever use a handful of fonts; this is just to keep programs that zoom text from growing the cache forever
+#define fontCacheMax 256
+
+static GHashTable *fontCache = NULL;
+
+static guint fontCacheHash(gconstpointer key)
+{
+	const uiFontDescriptor *d = (const uiFontDescriptor *) key;
+	guint h;
+
+	h = g_str_hash(d->Family);
+	h = h * 31 + g_double_hash(&(d->Size));
+	h = h * 31 + d->Weight;
+	h = h * 31 + d->Italic;
+	h = h * 31 + d->Stretch;
+	return h;
+}
+
+static gboolean fontCacheEqual(gconstpointer a, gconstpointer b)
+{
+	const uiFontDescriptor *da = (const uiFontDescriptor *) a;
+	const uiFontDescriptor *db = (const uiFontDescriptor *) b;
+
+	return strcmp(da->Family, db->Family) == 0 &&
+		da->Size == db->Size &&
+		da->Weight == db->Weight &&
+		da->Italic == db->Italic &&
+		da->Stretch == db->Stretch;
+}
+
+static void fontCacheEntryFree(gpointer data)
+{
+	struct fontCacheEntry *e = (struct fontCacheEntry *) data;
+
+	if (e->metrics != NULL)
+		pango_font_metrics_unref(e->metrics);
+	if (e->font != NULL)
+		g_object_unref(e->font);
+	pango_font_description_free(e->desc);
+	g_free(e->key.Family);
+	uiprivFree(e);
+}
+
+static struct fontCacheEntry *fontCacheLookup(const uiFontDescriptor *uidesc)
+{
+	struct fontCacheEntry *e;
+
+	if (fontCache == NULL)
+		fontCache = g_hash_table_new_full(fontCacheHash, fontCacheEqual,
+			NULL, fontCacheEntryFree);
+	e = (struct fontCacheEntry *) g_hash_table_lookup(fontCache, uidesc);
+	if (e != NULL)
+		return e;
+
+	if (g_hash_table_size(fontCache) >= fontCacheMax)
+		g_hash_table_remove_all(fontCache);
+	e = uiprivNew(struct fontCacheEntry);
+	e->key = *uidesc;
+	e->key.Family = g_strdup(uidesc->Family);
+	e->desc = uiprivFontDescriptorToPangoFontDescription(uidesc);
+	g_hash_table_insert(fontCache, &(e->key), e);
+	return e;
+}
+
+// the returned objects are owned by the cache and are only valid until the next call to one of these functions; copy or ref them if you need them for longer
+const PangoFontDescription *uiprivCachedPangoFontDescription(const uiFontDescriptor *uidesc)
+{
+	return fontCacheLookup(uidesc)->desc;
+}
+
+static void fontCacheLoadFont(struct fontCacheEntry *e)
+{
+	PangoContext *context;
+
+	if (e->font != NULL)
+		return;
+	// see drawtext.c for why we use this context
+	context = gdk_pango_context_get();
+	e->font = pango_context_load_font(context, e->desc);
+	g_object_unref(context);
+	if (e->font == NULL)
+		uiprivImplBug("error loading font %s", e->key.Family);
+}
+
+PangoFont *uiprivCachedPangoFont(const uiFontDescriptor *uidesc)
+{
+	struct fontCacheEntry *e;
+
+	e = fontCacheLookup(uidesc);
+	fontCacheLoadFont(e);
+	return e->font;
+}
+
+PangoFontMetrics *uiprivCachedPangoFontMetrics(const uiFontDescriptor *uidesc)
+{
+	struct fontCacheEntry *e;
+
+	e = fontCacheLookup(uidesc);
+	if (e->metrics == NULL) {
+		fontCacheLoadFont(e);
+		// NULL means use the default language
+		e->metrics = pango_font_get_metrics(e->font, NULL);
+	}
+	return e->metrics;
+}
+
+void uiprivUninitFontCache(void)
+{
+	if (fontCache == NULL)
+		return;
+	g_hash_table_destroy(fontCache);
+	fontCache = NULL;
+}
+
 void uiprivFontDescriptorFromPangoFontDescription(PangoFontDescription *pdesc, uiFontDescriptor *uidesc)
 {
 	PangoStyle pitalic;
@@ -0,0 +1,127 @@
+// 18 october 2026
+#include "uipriv_unix.h"
+#include "attrstr.h"
+
+// on a cold start, the first piece of text drawn has to wait for fontconfig to load its configuration and caches and for the fonts themselves to be opened, which can take hundreds of milliseconds
+// if asked to, we do that on a background thread during uiInit() instead
+// the thread uses a font map of its own because font maps are not thread-safe, so that only warms up the things that are process-wide (fontconfig and cairo's font face cache)
+// uiDrawNewTextLayout() uses the main thread's default font map, which has its own cache of loaded fonts, so once the thread is done we load the same fonts through that on the main thread too; with fontconfig already warm, that part is quick
+
+static GThread *warmUpThread = NULL;
+// the main thread's copy of the control font; non-NULL while the main thread's part is still queued
+static PangoFontDescription *warmUpDesc = NULL;
+static gint64 warmUpStart;
+static gint64 warmUpTime;
+static gint warmUpDone = 0;
+
+static const char *const commonFamilies[] = {
+	"Sans",
+	"Serif",
+	"Monospace",
+	NULL,
+};
+
+static void warmUpFont(PangoContext *context, const PangoFontDescription *desc)
+{
+	PangoFont *font;
+
+	font = pango_context_load_font(context, desc);
+	if (font == NULL)
+		return;
+	// getting the metrics forces the font file to actually be opened and a bit of text to be shaped
+	pango_font_metrics_unref(pango_font_get_metrics(font, NULL));
+	g_object_unref(font);
+}
+
+// this modifies desc
+static void warmUpFonts(PangoContext *context, PangoFontDescription *desc)
+{
+	int i;
+
+	// desc starts out as the control font
+	warmUpFont(context, desc);
+	for (i = 0; commonFamilies[i] != NULL; i++) {
+		pango_font_description_set_family(desc, commonFamilies[i]);
+		warmUpFont(context, desc);
+	}
+}
+
+static gboolean warmUpDefaultFontMap(gpointer data)
+{
+	PangoContext *context;
+
+	// this is the same context uiDrawNewTextLayout() uses
+	context = gdk_pango_context_get();
+	warmUpFonts(context, warmUpDesc);
+	g_object_unref(context);
+	pango_font_description_free(warmUpDesc);
+	warmUpDesc = NULL;
+
+	warmUpTime = g_get_monotonic_time() - warmUpStart;
+	// this is a full memory barrier, so warmUpTime is safe to read once this is set
+	g_atomic_int_set(&warmUpDone, 1);
+	return FALSE;
+}
+
+static gpointer warmUp(gpointer data)
+{
+	PangoFontDescription *desc = (PangoFontDescription *) data;
+	PangoFontMap *fontmap;
+	PangoContext *context;
+	PangoFontFamily **families;
+	int nFamilies;
+
+	fontmap = pango_cairo_font_map_new();
+	context = pango_font_map_create_context(fontmap);
+
+	// this is what loads the fontconfig configuration and caches
+	// while we're at it, fill in the list for uiListFontFamilies()
+	pango_font_map_list_families(fontmap, &families, &nFamilies);
+	uiprivSetFontFamilyList(uiprivNewFontFamilyList(families, nFamilies));
+	g_free(families);
+
+	warmUpFonts(context, desc);
+
+	pango_font_description_free(desc);
+	g_object_unref(context);
+	g_object_unref(fontmap);
+
+	g_idle_add(warmUpDefaultFontMap, &warmUpDesc);
+	return NULL;
+}
+
+void uiprivStartFontWarmUp(void)
+{
+	uiFontDescriptor f;
+
+	warmUpStart = g_get_monotonic_time();
+	// uiLoadControlFont() uses GTK+, which can only be used on the main thread, so find out what the control font is here and only load it on the warm-up thread
+	uiLoadControlFont(&f);
+	warmUpDesc = uiprivFontDescriptorToPangoFontDescription(&f);
+	uiFreeFontDescriptor(&f);
+	warmUpThread = g_thread_new("libui font warm-up", warmUp, pango_font_description_copy(warmUpDesc));
+}
+
+void uiprivStopFontWarmUp(void)
+{
+	if (warmUpThread == NULL)
+		return;
+	g_thread_join(warmUpThread);
+	warmUpThread = NULL;
+	// the thread is done, so if the main thread's part hasn't run yet, it's sitting in the idle queue
+	if (warmUpDesc != NULL) {
+		g_idle_remove_by_data(&warmUpDesc);
+		pango_font_description_free(warmUpDesc);
+		warmUpDesc = NULL;
+	}
+	g_atomic_int_set(&warmUpDone, 0);
+}
+
+int uiFontWarmUpStats(double *seconds)
+{
+	if (!g_atomic_int_get(&warmUpDone))
+		return 0;
+	if (seconds != NULL)
+		*seconds = ((double) warmUpTime) / G_USEC_PER_SEC;
+	return 1;
+}
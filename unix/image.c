@@ -1,10 +1,13 @@
 // 27 june 2016
 #include "uipriv_unix.h"
+#include "draw.h"
 
 struct uiImage {
 	double width;
 	double height;
 	GPtrArray *images;
+	// for uiDrawImage(); see below
+	GPtrArray *scaled;
 };
 
 static void freeImageRep(gpointer item)
@@ -14,6 +17,25 @@ static void freeImageRep(gpointer item)
 	cairo_surface_destroy(cs);
 }
 
+// uiDrawImage() keeps the last few resized copies of each image around, most recently used first
+#define maxScaledImages 4
+
+struct scaledImage {
+	cairo_surface_t *src;
+	int width;
+	int height;
+	uiDrawImageFilter filter;
+	cairo_surface_t *cs;
+};
+
+static void freeScaledImage(gpointer item)
+{
+	struct scaledImage *si = (struct scaledImage *) item;
+
+	cairo_surface_destroy(si->cs);
+	g_free(si);
+}
+
 uiImage *uiNewImage(double width, double height)
 {
 	uiImage *i;
@@ -22,11 +44,13 @@ uiImage *uiNewImage(double width, double height)
 	i->width = width;
 	i->height = height;
 	i->images = g_ptr_array_new_with_free_func(freeImageRep);
+	i->scaled = g_ptr_array_new_with_free_func(freeScaledImage);
 	return i;
 }
 
 void uiFreeImage(uiImage *i)
 {
+	g_ptr_array_free(i->scaled, TRUE);
 	g_ptr_array_free(i->images, TRUE);
 	uiprivFree(i);
 }
@@ -71,6 +95,8 @@ void uiImageAppend(uiImage *i, void *pixels, int pixelWidth, int pixelHeight, in
 
 	cairo_surface_mark_dirty(cs);
 	g_ptr_array_add(i->images, cs);
+	// a new representation may be a better match than the one a resized copy was made from
+	g_ptr_array_set_size(i->scaled, 0);
 }
 
 struct matcher {
@@ -120,16 +146,135 @@ writeMatch:
 	m->distY = abs(m->targetY - y);
 }
 
-cairo_surface_t *uiprivImageAppropriateSurface(uiImage *i, GtkWidget *w)
+static cairo_surface_t *appropriateSurface(uiImage *i, int targetX, int targetY)
 {
 	struct matcher m;
 
 	m.best = NULL;
 	m.distX = G_MAXINT;
 	m.distY = G_MAXINT;
-	m.targetX = i->width * gtk_widget_get_scale_factor(w);
-	m.targetY = i->height * gtk_widget_get_scale_factor(w);
+	m.targetX = targetX;
+	m.targetY = targetY;
 	m.foundLarger = FALSE;
 	g_ptr_array_foreach(i->images, match, &m);
 	return m.best;
 }
+
+cairo_surface_t *uiprivImageAppropriateSurface(uiImage *i, GtkWidget *w)
+{
+	return appropriateSurface(i,
+		i->width * gtk_widget_get_scale_factor(w),
+		i->height * gtk_widget_get_scale_factor(w));
+}
+
+static const cairo_filter_t filters[] = {
+	[uiDrawImageFilterNearest] = CAIRO_FILTER_NEAREST,
+	[uiDrawImageFilterLinear] = CAIRO_FILTER_BILINEAR,
+	[uiDrawImageFilterSmooth] = CAIRO_FILTER_BEST,
+};
+
+// tiled uiAreas can draw the same image on several threads at once
+static GMutex scaledLock;
+
+// this returns a new reference
+static cairo_surface_t *scaledSurface(uiImage *i, cairo_surface_t *src, int width, int height, uiDrawImageFilter filter)
+{
+	struct scaledImage *si;
+	cairo_t *cr;
+	guint n;
+
+	g_mutex_lock(&scaledLock);
+	for (n = 0; n < i->scaled->len; n++) {
+		si = (struct scaledImage *) g_ptr_array_index(i->scaled, n);
+		if (si->src == src && si->width == width && si->height == height && si->filter == filter) {
+			// move it to the front so it's the last to go
+			// (g_ptr_array_remove_index() would free it, and g_ptr_array_steal_index() is too new)
+			for (; n > 0; n--)
+				i->scaled->pdata[n] = i->scaled->pdata[n - 1];
+			i->scaled->pdata[0] = si;
+			cairo_surface_reference(si->cs);
+			g_mutex_unlock(&scaledLock);
+			return si->cs;
+		}
+	}
+
+	si = g_new0(struct scaledImage, 1);
+	si->src = src;
+	si->width = width;
+	si->height = height;
+	si->filter = filter;
+	si->cs = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+	cr = cairo_create(si->cs);
+	cairo_scale(cr,
+		((double) width) / cairo_image_surface_get_width(src),
+		((double) height) / cairo_image_surface_get_height(src));
+	cairo_set_source_surface(cr, src, 0, 0);
+	cairo_pattern_set_filter(cairo_get_source(cr), filters[filter]);
+	// otherwise the edges fade into transparency
+	cairo_pattern_set_extend(cairo_get_source(cr), CAIRO_EXTEND_PAD);
+	cairo_paint(cr);
+	cairo_destroy(cr);
+	cairo_surface_flush(si->cs);
+
+	if (i->scaled->len == maxScaledImages)
+		g_ptr_array_remove_index(i->scaled, maxScaledImages - 1);
+	g_ptr_array_insert(i->scaled, 0, si);
+	cairo_surface_reference(si->cs);
+	g_mutex_unlock(&scaledLock);
+	return si->cs;
+}
+
+void uiDrawImage(uiDrawContext *c, uiImage *i, double x, double y, double width, double height, uiDrawImageFilter filter)
+{
+	double wx, wy, hx, hy;
+	double sx, sy;
+	int targetX, targetY;
+	cairo_surface_t *src, *cs;
+
+	if (i->images->len == 0)
+		uiprivUserBug("You cannot draw a uiImage that has no representations. (image: %p)", i);
+	if (width <= 0 || height <= 0)
+		return;
+
+	// figure out how many device pixels the image will cover, whatever the transform is
+	wx = width;
+	wy = 0;
+	cairo_user_to_device_distance(c->cr, &wx, &wy);
+	hx = 0;
+	hy = height;
+	cairo_user_to_device_distance(c->cr, &hx, &hy);
+	sx = 1;
+	sy = 1;
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 14, 0)
+	// HiDPI surfaces do their scaling outside of the CTM
+	cairo_surface_get_device_scale(cairo_get_target(c->cr), &sx, &sy);
+#endif
+	targetX = (int) ceil(hypot(wx, wy) * sx);
+	targetY = (int) ceil(hypot(hx, hy) * sy);
+	if (targetX < 1)
+		targetX = 1;
+	if (targetY < 1)
+		targetY = 1;
+
+	src = appropriateSurface(i, targetX, targetY);
+	if (cairo_image_surface_get_width(src) == targetX && cairo_image_surface_get_height(src) == targetY)
+		cs = cairo_surface_reference(src);
+	else
+		cs = scaledSurface(i, src, targetX, targetY, filter);
+
+	// as with uiDrawLayer(), cairo_restore() puts back everything this changes
+	cairo_save(c->cr);
+	cairo_rectangle(c->cr, x, y, width, height);
+	cairo_clip(c->cr);
+	cairo_translate(c->cr, x, y);
+	cairo_scale(c->cr,
+		width / cairo_image_surface_get_width(cs),
+		height / cairo_image_surface_get_height(cs));
+	cairo_set_source_surface(c->cr, cs, 0, 0);
+	// if the transform is only a translation by whole pixels, this is a straight copy whatever the filter
+	cairo_pattern_set_filter(cairo_get_source(c->cr), filters[filter]);
+	cairo_pattern_set_extend(cairo_get_source(c->cr), CAIRO_EXTEND_PAD);
+	cairo_paint(c->cr);
+	cairo_restore(c->cr);
+	cairo_surface_destroy(cs);
+}
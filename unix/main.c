@@ -10,7 +10,7 @@ const char *uiInit(uiInitOptions *o)
 	GError *err = NULL;
 	const char *msg;
 
-	uiprivOptions = *o;
+	uiprivLoadInitOptions(o);
 	if (gtk_init_with_args(NULL, NULL, NULL, NULL, NULL, &err) == FALSE) {
 		msg = g_strdup(err->message);
 		g_error_free(err);
@@ -19,6 +19,9 @@ const char *uiInit(uiInitOptions *o)
 	uiprivInitAlloc();
 	uiprivLoadFutures();
 	timers = g_hash_table_new(g_direct_hash, g_direct_equal);
+	uiprivInitFontFamilies();
+	if ((uiprivOptions.Flags & uiInitFlagWarmUpFonts) != 0)
+		uiprivStartFontWarmUp();
 	return NULL;
 }
 
@@ -34,6 +37,11 @@ void uiUninit(void)
 	g_hash_table_foreach(timers, uninitTimer, NULL);
 	g_hash_table_destroy(timers);
 	uiprivUninitMenus();
+	uiprivStopFontWarmUp();
+	uiprivUninitFontFamilies();
+	uiprivUninitDraw();
+	uiprivUninitDrawText();
+	uiprivUninitFontCache();
 	uiprivUninitAlloc();
 }
 
@@ -46,6 +46,23 @@ extern void uiprivChildSetMargined(uiprivChild *c, int margined);
 // draw.c
 extern uiDrawContext *uiprivNewContext(cairo_t *cr, GtkStyleContext *style);
 extern void uiprivFreeContext(uiDrawContext *);
+extern void uiprivUninitDraw(void);
+
+// drawtext.c
+extern void uiprivUninitDrawText(void);
+
+// fontfamilies.c
+extern GPtrArray *uiprivNewFontFamilyList(PangoFontFamily **pfamilies, int n);
+extern void uiprivSetFontFamilyList(GPtrArray *list);
+extern void uiprivInitFontFamilies(void);
+extern void uiprivUninitFontFamilies(void);
+
+// fontmatch.c
+extern void uiprivUninitFontCache(void);
+
+// fontwarmup.c
+extern void uiprivStartFontWarmUp(void);
+extern void uiprivStopFontWarmUp(void);
 
 // image.c
 extern cairo_surface_t *uiprivImageAppropriateSurface(uiImage *i, GtkWidget *w);
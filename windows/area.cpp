@@ -24,6 +24,9 @@ static LRESULT CALLBACK areaWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM
 		return DefWindowProcW(hwnd, uMsg, wParam, lParam);
 	}
 
+	if (uMsg == WM_DESTROY)
+		uiprivFallbackSetAnimationCallback(a, NULL, NULL);
+
 	// always recreate the render target if necessary
 	if (a->rt == NULL)
 		a->rt = makeHWNDRenderTarget(a->hwnd);
@@ -95,9 +98,100 @@ void uiAreaQueueRedrawAll(uiArea *a)
 	invalidateRect(a->hwnd, NULL, FALSE);
 }
 
+void uiAreaQueueRedrawRect(uiArea *a, double x, double y, double width, double height)
+{
+	double r[4];
+
+	r[0] = x;
+	r[1] = y;
+	r[2] = width;
+	r[3] = height;
+	uiAreaQueueRedrawRects(a, r, 1);
+}
+
+// Windows adds each of these to the window's update region and sends a single WM_PAINT for all of them, so they coalesce on their own
+void uiAreaQueueRedrawRects(uiArea *a, const double *rects, size_t n)
+{
+	double x0, y0, x1, y1;
+	RECT r;
+	size_t i;
+
+	// we need the render target to convert to pixels, but if we don't have one, nothing was drawn yet anyway
+	if (a->rt == NULL) {
+		uiAreaQueueRedrawAll(a);
+		return;
+	}
+	for (i = 0; i < n; i++, rects += 4) {
+		if (rects[2] <= 0 || rects[3] <= 0)
+			continue;
+		x0 = rects[0];
+		y0 = rects[1];
+		x1 = x0 + rects[2];
+		y1 = y0 + rects[3];
+		if (a->scrolling) {
+			x0 -= a->hscrollpos;
+			y0 -= a->vscrollpos;
+			x1 -= a->hscrollpos;
+			y1 -= a->vscrollpos;
+		}
+		dipToPixels(a, &x0, &y0);
+		dipToPixels(a, &x1, &y1);
+		r.left = (LONG) floor(x0);
+		r.top = (LONG) floor(y0);
+		r.right = (LONG) ceil(x1);
+		r.bottom = (LONG) ceil(y1);
+		// don't erase the background; we do that ourselves in doPaint()
+		invalidateRect(a->hwnd, &r, FALSE);
+	}
+}
+
 void uiAreaScrollTo(uiArea *a, double x, double y, double width, double height)
 {
-	// TODO
+	if (!a->scrolling)
+		uiprivUserBug("You cannot call uiAreaScrollTo() on a non-scrolling uiArea. (area: %p)", a);
+	areaScrollTo(a, x, y, width, height);
+}
+
+// TODO Direct2D can't scroll what's already in the render target (see areascroll.cpp), so this would need a bitmap of our own
+void uiAreaSetBackingStore(uiArea *a, int enabled, double margin)
+{
+	if (!a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetBackingStore() on a non-scrolling uiArea. (area: %p)", a);
+}
+
+double uiAreaScaleFactor(uiArea *a)
+{
+	HDC dc;
+	int dpi;
+
+	// this is the same DPI that makeHWNDRenderTarget() uses
+	dc = GetDC(a->hwnd);
+	if (dc == NULL)
+		logLastError(L"error getting DC to find DPI");
+	dpi = GetDeviceCaps(dc, LOGPIXELSX);
+	if (ReleaseDC(a->hwnd, dc) == 0)
+		logLastError(L"error releasing DC for finding DPI");
+	return ((double) dpi) / 96;
+}
+
+// TODO use DwmFlush() or IDXGIOutput::WaitForVBlank() to line up with the display
+void uiAreaSetAnimationCallback(uiArea *a, uiAreaAnimationFunc f, void *data)
+{
+	uiprivFallbackSetAnimationCallback(a, f, data);
+}
+
+// TODO tiled rendering; for now Draw is always called once on the main thread, which a thread-safe Draw handler is fine with
+void uiAreaSetTiledRendering(uiArea *a, int tileSize, int threads)
+{
+	// do nothing
+}
+
+// Direct2D requires redrawing everything after ID2D1HwndRenderTarget::Resize() (see areaDrawOnResize()), so the only policy that could do anything here is uiAreaResizeDeferred
+// TODO implement that with a bitmap of the last frame
+void uiAreaSetResizePolicy(uiArea *a, uiAreaResizePolicy policy)
+{
+	if (a->scrolling)
+		uiprivUserBug("You cannot call uiAreaSetResizePolicy() on a scrolling uiArea. (area: %p)", a);
 }
 
 void uiAreaBeginUserWindowMove(uiArea *a)
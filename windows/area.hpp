@@ -36,6 +36,7 @@ extern void areaDrawOnResize(uiArea *, RECT *);
 extern BOOL areaDoScroll(uiArea *a, UINT uMsg, WPARAM wParam, LPARAM lParam, LRESULT *lResult);
 extern void areaScrollOnResize(uiArea *, RECT *);
 extern void areaUpdateScroll(uiArea *a);
+extern void areaScrollTo(uiArea *a, double x, double y, double width, double height);
 
 // areaevents.cpp
 extern BOOL areaDoEvents(uiArea *a, UINT uMsg, WPARAM wParam, LPARAM lParam, LRESULT *lResult);
@@ -238,6 +238,33 @@ BOOL areaDoScroll(uiArea *a, UINT uMsg, WPARAM wParam, LPARAM lParam, LRESULT *l
 	return FALSE;
 }
 
+// this scrolls as little as possible to show [start, end), favoring start if it doesn't fit
+static void scrollToShow(uiArea *a, int which, struct scrollParams *p, int start, int end)
+{
+	int pos;
+
+	pos = *(p->pos);
+	if (end > pos + p->pagesize)
+		pos = end - p->pagesize;
+	if (start < pos)
+		pos = start;
+	scrollto(a, which, p, pos);
+}
+
+void areaScrollTo(uiArea *a, double x, double y, double width, double height)
+{
+	struct scrollParams p;
+	double x1, y1;
+
+	// the scroll positions are in DIPs, the same as the area's coordinates, so there's nothing to convert
+	x1 = x + width;
+	y1 = y + height;
+	hscrollParams(a, &p);
+	scrollToShow(a, SB_HORZ, &p, (int) floor(x), (int) ceil(x1));
+	vscrollParams(a, &p);
+	scrollToShow(a, SB_VERT, &p, (int) floor(y), (int) ceil(y1));
+}
+
 void areaScrollOnResize(uiArea *a, RECT *client)
 {
 	areaUpdateScroll(a);
@@ -317,18 +317,15 @@ static void unapplyClip(uiDrawContext *c, ID2D1Layer *layer)
 	layer->Release();
 }
 
-void uiDrawStroke(uiDrawContext *c, uiDrawPath *p, uiDrawBrush *b, uiDrawStrokeParams *sp)
+// this is shared by uiDrawStroke() and uiDrawPathStrokeContainsPoint() so the two always agree
+static ID2D1StrokeStyle *makeStrokeStyle(uiDrawStrokeParams *sp)
 {
-	ID2D1Brush *brush;
 	ID2D1StrokeStyle *style;
 	D2D1_STROKE_STYLE_PROPERTIES dsp;
 	FLOAT *dashes;
 	size_t i;
-	ID2D1Layer *cliplayer;
 	HRESULT hr;
 
-	brush = makeBrush(b, c->rt);
-
 	ZeroMemory(&dsp, sizeof (D2D1_STROKE_STYLE_PROPERTIES));
 	switch (sp->Cap) {
 	case uiDrawLineCapFlat:
@@ -380,6 +377,62 @@ void uiDrawStroke(uiDrawContext *c, uiDrawPath *p, uiDrawBrush *b, uiDrawStrokeP
 	if (sp->NumDashes != 0)
 		uiprivFree(dashes);
 
+	return style;
+}
+
+// Direct2D still widens and tessellates geometry that lies entirely off the render target, so don't give it any
+// this only tests against the render target itself, not against c->currentClip; that's in user space as of whenever it was set, and the render target covers the common case of a zoomed-in view anyway
+// GetWidenedBounds() would be exact for strokes, but it widens the whole path to get there, which is what we're trying to avoid
+static bool culled(uiDrawContext *c, uiDrawPath *p, double outset)
+{
+	D2D1_RECT_F r;
+	D2D1::Matrix3x2F m;
+	D2D1_POINT_2F pts[4];
+	D2D1_SIZE_F size;
+	FLOAT x0, y0, x1, y1;
+	int i;
+	HRESULT hr;
+
+	hr = pathGeometry(p)->GetBounds(NULL, &r);
+	if (hr != S_OK)
+		logHRESULT(L"error getting path bounds", hr);
+	// empty geometries have left > right
+	if (r.left > r.right || r.top > r.bottom)
+		goto cull;
+	pts[0] = D2D1::Point2F(r.left - outset, r.top - outset);
+	pts[1] = D2D1::Point2F(r.right + outset, r.top - outset);
+	pts[2] = D2D1::Point2F(r.left - outset, r.bottom + outset);
+	pts[3] = D2D1::Point2F(r.right + outset, r.bottom + outset);
+	c->rt->GetTransform(&m);
+	for (i = 0; i < 4; i++)
+		pts[i] = m.TransformPoint(pts[i]);
+	x0 = x1 = pts[0].x;
+	y0 = y1 = pts[0].y;
+	for (i = 1; i < 4; i++) {
+		x0 = min(x0, pts[i].x);
+		y0 = min(y0, pts[i].y);
+		x1 = max(x1, pts[i].x);
+		y1 = max(y1, pts[i].y);
+	}
+	size = c->rt->GetSize();
+	if (x1 > 0 && x0 < size.width && y1 > 0 && y0 < size.height)
+		return false;
+cull:
+	c->stats.CulledOperations++;
+	return true;
+}
+
+void uiDrawStroke(uiDrawContext *c, uiDrawPath *p, uiDrawBrush *b, uiDrawStrokeParams *sp)
+{
+	ID2D1Brush *brush;
+	ID2D1StrokeStyle *style;
+	ID2D1Layer *cliplayer;
+
+	if (culled(c, p, uiprivStrokeOutset(sp)))
+		return;
+	brush = makeBrush(b, c->rt);
+	style = makeStrokeStyle(sp);
+
 	cliplayer = applyClip(c);
 	c->rt->DrawGeometry(
 		pathGeometry(p),
@@ -397,6 +450,8 @@ void uiDrawFill(uiDrawContext *c, uiDrawPath *p, uiDrawBrush *b)
 	ID2D1Brush *brush;
 	ID2D1Layer *cliplayer;
 
+	if (culled(c, p, 0))
+		return;
 	brush = makeBrush(b, c->rt);
 	cliplayer = applyClip(c);
 	c->rt->FillGeometry(
@@ -407,6 +462,72 @@ void uiDrawFill(uiDrawContext *c, uiDrawPath *p, uiDrawBrush *b)
 	brush->Release();
 }
 
+int uiDrawPathContainsPoint(uiDrawPath *p, double x, double y)
+{
+	BOOL contains;
+	HRESULT hr;
+
+	// the fill mode is part of the geometry, so there's nothing else to pass along
+	hr = pathGeometry(p)->FillContainsPoint(D2D1::Point2F(x, y), NULL, &contains);
+	if (hr != S_OK)
+		logHRESULT(L"error hit-testing path fill", hr);
+	return contains ? 1 : 0;
+}
+
+int uiDrawPathStrokeContainsPoint(uiDrawPath *p, double x, double y, uiDrawStrokeParams *sp)
+{
+	ID2D1StrokeStyle *style;
+	BOOL contains;
+	HRESULT hr;
+
+	style = makeStrokeStyle(sp);
+	hr = pathGeometry(p)->StrokeContainsPoint(D2D1::Point2F(x, y), sp->Thickness, style, NULL, &contains);
+	if (hr != S_OK)
+		logHRESULT(L"error hit-testing path stroke", hr);
+	style->Release();
+	return contains ? 1 : 0;
+}
+
+// TODO keep the native brush around too; Direct2D brushes belong to a render target and Core Graphics gradients depend on the path, so for now this only saves copying the brush
+struct uiDrawCachedBrush {
+	uiDrawBrush b;
+};
+
+uiDrawCachedBrush *uiDrawNewBrush(const uiDrawBrush *b)
+{
+	uiDrawCachedBrush *cb;
+
+	cb = uiprivNew(uiDrawCachedBrush);
+	uiprivCopyBrush(&(cb->b), b);
+	return cb;
+}
+
+void uiDrawFreeBrush(uiDrawCachedBrush *b)
+{
+	uiprivFreeBrushCopy(&(b->b));
+	uiprivFree(b);
+}
+
+void uiDrawStrokeCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b, uiDrawStrokeParams *p)
+{
+	uiDrawStroke(c, path, &(b->b), p);
+}
+
+void uiDrawFillCachedBrush(uiDrawContext *c, uiDrawPath *path, uiDrawCachedBrush *b)
+{
+	uiDrawFill(c, path, &(b->b));
+}
+
+void uiDrawFillRects(uiDrawContext *c, const double *rects, size_t n, uiDrawBrush *b)
+{
+	uiprivFallbackFillRects(c, rects, n, b);
+}
+
+void uiDrawFillRectsColored(uiDrawContext *c, const double *rects, const double *colors, size_t n)
+{
+	uiprivFallbackFillRectsColored(c, rects, colors, n);
+}
+
 void uiDrawTransform(uiDrawContext *c, uiDrawMatrix *m)
 {
 	D2D1_MATRIX_3X2_F dm, cur;
@@ -471,6 +592,92 @@ struct drawState {
 	ID2D1PathGeometry *clip;
 };
 
+void uiDrawLayer(uiDrawContext *c, uiDrawCachedLayer *l, double x, double y)
+{
+	IWICBitmap *wb;
+	ID2D1Bitmap *bitmap;
+	ID2D1Layer *cliplayer;
+	D2D1_RECT_F dest;
+	double width, height;
+	HRESULT hr;
+
+	wb = uiprivLayerBitmap(l, c, &width, &height);
+	// Direct2D bitmaps belong to a render target, so we have to make a new one each time
+	// TODO cache it per render target
+	hr = c->rt->CreateBitmapFromWicBitmap(wb, NULL, &bitmap);
+	if (hr != S_OK)
+		logHRESULT(L"error creating bitmap for uiDrawCachedLayer", hr);
+	dest.left = x;
+	dest.top = y;
+	dest.right = x + width;
+	dest.bottom = y + height;
+	cliplayer = applyClip(c);
+	c->rt->DrawBitmap(bitmap, &dest, 1.0, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, NULL);
+	unapplyClip(c, cliplayer);
+	bitmap->Release();
+}
+
+void uiDrawPixels(uiDrawContext *c, uiDrawPixelBuffer *pb, double x, double y, double width, double height)
+{
+	ID2D1Bitmap *bitmap;
+	ID2D1Layer *cliplayer;
+	D2D1_RECT_F dest;
+
+	if (width <= 0 || height <= 0)
+		return;
+	// unlike with uiDrawLayer(), the bitmap is cached, so don't release it
+	bitmap = uiprivPixelBufferBitmap(pb, c);
+	dest.left = x;
+	dest.top = y;
+	dest.right = x + width;
+	dest.bottom = y + height;
+	cliplayer = applyClip(c);
+	c->rt->DrawBitmap(bitmap, &dest, 1.0, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, NULL);
+	unapplyClip(c, cliplayer);
+}
+
+void uiDrawImage(uiDrawContext *c, uiImage *i, double x, double y, double width, double height, uiDrawImageFilter filter)
+{
+	D2D1_MATRIX_3X2_F m;
+	FLOAT dpix, dpiy;
+	int targetX, targetY;
+	ID2D1Bitmap *bitmap;
+	ID2D1Layer *cliplayer;
+	D2D1_RECT_F dest;
+	D2D1_BITMAP_INTERPOLATION_MODE mode;
+
+	if (width <= 0 || height <= 0)
+		return;
+	// figure out how many device pixels the image will cover, whatever the transform is
+	c->rt->GetTransform(&m);
+	c->rt->GetDpi(&dpix, &dpiy);
+	targetX = (int) ceil(hypot(width * m._11, width * m._12) * dpix / 96);
+	targetY = (int) ceil(hypot(height * m._21, height * m._22) * dpiy / 96);
+	if (targetX < 1)
+		targetX = 1;
+	if (targetY < 1)
+		targetY = 1;
+
+	// the bitmap is already the right size, so Direct2D only resamples it if the transform rotates or skews; it's cached, so don't release it
+	bitmap = uiprivImageBitmap(i, c, targetX, targetY, filter);
+	dest.left = x;
+	dest.top = y;
+	dest.right = x + width;
+	dest.bottom = y + height;
+	mode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
+	if (filter == uiDrawImageFilterNearest)
+		mode = D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR;
+	cliplayer = applyClip(c);
+	c->rt->DrawBitmap(bitmap, &dest, 1.0, mode, NULL);
+	unapplyClip(c, cliplayer);
+}
+
+// TODO keep the rest of these
+void uiDrawContextStats(uiDrawContext *c, uiDrawStats *s)
+{
+	*s = c->stats;
+}
+
 void uiDrawSave(uiDrawContext *c)
 {
 	struct drawState state;
@@ -10,13 +10,23 @@ struct uiDrawContext {
 	// TODO find out how this works
 	std::vector<struct drawState> *states;
 	ID2D1PathGeometry *currentClip;
+	uiDrawStats stats;
 };
 
 // drawpath.cpp
 extern ID2D1PathGeometry *pathGeometry(uiDrawPath *p);
 
+// drawlayer.cpp
+extern IWICBitmap *uiprivLayerBitmap(uiDrawCachedLayer *l, uiDrawContext *c, double *width, double *height);
+
 // drawmatrix.cpp
 extern void m2d(uiDrawMatrix *m, D2D1_MATRIX_3X2_F *d);
 
+// drawpixelbuffer.cpp
+extern ID2D1Bitmap *uiprivPixelBufferBitmap(uiDrawPixelBuffer *pb, uiDrawContext *c);
+
+// image.cpp
+extern ID2D1Bitmap *uiprivImageBitmap(uiImage *i, uiDrawContext *c, int width, int height, uiDrawImageFilter filter);
+
 #endif
 
@@ -0,0 +1,166 @@
+// 18 october 2026
+#include "uipriv_windows.hpp"
+#include "draw.hpp"
+
+// this is the same WIC bitmap and render target pair as a uiDrawCachedLayer, except it's always being drawn into
+// Direct2D only finishes drawing into the bitmap on EndDraw(), so we end drawing whenever someone wants to look at the pixels and begin again on the next drawing call
+struct uiDrawImageContext {
+	IWICBitmap *bitmap;
+	ID2D1RenderTarget *rt;
+	uiDrawContext *c;
+	BOOL drawing;
+	UINT width;
+	UINT height;
+	// WIC bitmaps can only be read through a lock, so uiDrawImageContextPixels() returns a copy
+	uint8_t *pixels;
+};
+
+static void beginDraw(uiDrawImageContext *ic)
+{
+	if (ic->drawing)
+		return;
+	ic->rt->BeginDraw();
+	ic->drawing = TRUE;
+}
+
+static void endDraw(uiDrawImageContext *ic)
+{
+	HRESULT hr;
+
+	if (!ic->drawing)
+		return;
+	hr = ic->rt->EndDraw(NULL, NULL);
+	if (hr != S_OK)
+		logHRESULT(L"error drawing into uiDrawImageContext", hr);
+	ic->drawing = FALSE;
+}
+
+uiDrawImageContext *uiDrawNewImageContext(double width, double height, double scale)
+{
+	uiDrawImageContext *ic;
+	D2D1_RENDER_TARGET_PROPERTIES props;
+	D2D1_COLOR_F transparent;
+	HRESULT hr;
+
+	if (scale <= 0)
+		uiprivUserBug("You cannot create a uiDrawImageContext with a scale of %g.", scale);
+	ic = uiprivNew(uiDrawImageContext);
+	ic->width = (UINT) ceil(width * scale);
+	ic->height = (UINT) ceil(height * scale);
+	// on little-endian systems (which is all Windows runs on) this is the 0xAARRGGBB that uiDrawImageContextPixels() promises
+	hr = uiprivWICFactory->CreateBitmap(ic->width, ic->height,
+		GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnDemand,
+		&(ic->bitmap));
+	if (hr != S_OK)
+		logHRESULT(L"error creating uiDrawImageContext bitmap", hr);
+
+	ZeroMemory(&props, sizeof (D2D1_RENDER_TARGET_PROPERTIES));
+	props.type = D2D1_RENDER_TARGET_TYPE_DEFAULT;
+	props.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	props.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+	// this makes drawing coordinates DIPs, as with areas
+	props.dpiX = 96 * scale;
+	props.dpiY = 96 * scale;
+	props.usage = D2D1_RENDER_TARGET_USAGE_NONE;
+	props.minLevel = D2D1_FEATURE_LEVEL_DEFAULT;
+	hr = d2dfactory->CreateWicBitmapRenderTarget(ic->bitmap, &props, &(ic->rt));
+	if (hr != S_OK)
+		logHRESULT(L"error creating uiDrawImageContext render target", hr);
+
+	ic->c = newContext(ic->rt);
+	beginDraw(ic);
+	ZeroMemory(&transparent, sizeof (D2D1_COLOR_F));
+	ic->rt->Clear(&transparent);
+	return ic;
+}
+
+void uiDrawFreeImageContext(uiDrawImageContext *ic)
+{
+	endDraw(ic);
+	freeContext(ic->c);
+	if (ic->pixels != NULL)
+		uiprivFree(ic->pixels);
+	ic->rt->Release();
+	ic->bitmap->Release();
+	uiprivFree(ic);
+}
+
+uiDrawContext *uiDrawImageContextContext(uiDrawImageContext *ic)
+{
+	// the caller is about to draw, so be ready for it
+	beginDraw(ic);
+	return ic->c;
+}
+
+void uiDrawImageContextClear(uiDrawImageContext *ic)
+{
+	D2D1_COLOR_F transparent;
+
+	beginDraw(ic);
+	ZeroMemory(&transparent, sizeof (D2D1_COLOR_F));
+	ic->rt->Clear(&transparent);
+}
+
+const uint8_t *uiDrawImageContextPixels(uiDrawImageContext *ic, int *width, int *height, int *stride)
+{
+	HRESULT hr;
+
+	endDraw(ic);
+	if (ic->pixels == NULL)
+		ic->pixels = (uint8_t *) uiprivAlloc(ic->width * ic->height * 4, "uint8_t[]");
+	hr = ic->bitmap->CopyPixels(NULL, ic->width * 4, ic->width * ic->height * 4, ic->pixels);
+	if (hr != S_OK)
+		logHRESULT(L"error reading uiDrawImageContext pixels", hr);
+	// anything drawn from now on goes into a new BeginDraw()/EndDraw() pair
+	beginDraw(ic);
+	*width = ic->width;
+	*height = ic->height;
+	*stride = ic->width * 4;
+	return ic->pixels;
+}
+
+int uiDrawImageContextWritePNG(uiDrawImageContext *ic, const char *filename)
+{
+	WCHAR *wfilename;
+	IWICStream *stream = NULL;
+	IWICBitmapEncoder *encoder = NULL;
+	IWICBitmapFrameEncode *frame = NULL;
+	WICPixelFormatGUID format;
+	HRESULT hr;
+
+	endDraw(ic);
+	wfilename = toUTF16(filename);
+	hr = uiprivWICFactory->CreateStream(&stream);
+	if (hr == S_OK)
+		hr = stream->InitializeFromFilename(wfilename, GENERIC_WRITE);
+	if (hr == S_OK)
+		hr = uiprivWICFactory->CreateEncoder(GUID_ContainerFormatPng, NULL, &encoder);
+	if (hr == S_OK)
+		hr = encoder->Initialize(stream, WICBitmapEncoderNoCache);
+	if (hr == S_OK)
+		hr = encoder->CreateNewFrame(&frame, NULL);
+	if (hr == S_OK)
+		hr = frame->Initialize(NULL);
+	if (hr == S_OK)
+		hr = frame->SetSize(ic->width, ic->height);
+	if (hr == S_OK) {
+		// the PNG encoder doesn't do premultiplied alpha; this changes format to what it does do, and WriteSource() converts for us
+		format = GUID_WICPixelFormat32bppPBGRA;
+		hr = frame->SetPixelFormat(&format);
+	}
+	if (hr == S_OK)
+		hr = frame->WriteSource(ic->bitmap, NULL);
+	if (hr == S_OK)
+		hr = frame->Commit();
+	if (hr == S_OK)
+		hr = encoder->Commit();
+	if (frame != NULL)
+		frame->Release();
+	if (encoder != NULL)
+		encoder->Release();
+	if (stream != NULL)
+		stream->Release();
+	uiprivFree(wfilename);
+	beginDraw(ic);
+	return hr == S_OK;
+}
@@ -0,0 +1,103 @@
+// 18 october 2026
+#include "uipriv_windows.hpp"
+#include "draw.hpp"
+
+// layers are WIC bitmaps with their own render target, so they don't depend on any particular window's render target
+// that means they are drawn in software, but that's fine for things that are only redrawn when they change
+struct uiDrawCachedLayer {
+	double width;
+	double height;
+	double scale;
+	IWICBitmap *bitmap;
+	ID2D1RenderTarget *rt;
+	uiDrawContext *c;
+	BOOL valid;
+};
+
+uiDrawCachedLayer *uiDrawNewLayer(double width, double height, double scale)
+{
+	uiDrawCachedLayer *l;
+	D2D1_RENDER_TARGET_PROPERTIES props;
+	HRESULT hr;
+
+	if (scale <= 0)
+		uiprivUserBug("You cannot create a uiDrawCachedLayer with a scale of %g.", scale);
+	l = uiprivNew(uiDrawCachedLayer);
+	l->width = width;
+	l->height = height;
+	l->scale = scale;
+	hr = uiprivWICFactory->CreateBitmap((UINT) ceil(width * scale), (UINT) ceil(height * scale),
+		GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnDemand,
+		&(l->bitmap));
+	if (hr != S_OK)
+		logHRESULT(L"error creating uiDrawCachedLayer bitmap", hr);
+
+	ZeroMemory(&props, sizeof (D2D1_RENDER_TARGET_PROPERTIES));
+	props.type = D2D1_RENDER_TARGET_TYPE_DEFAULT;
+	props.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	props.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+	// this makes drawing coordinates DIPs, as with areas
+	props.dpiX = 96 * scale;
+	props.dpiY = 96 * scale;
+	props.usage = D2D1_RENDER_TARGET_USAGE_NONE;
+	props.minLevel = D2D1_FEATURE_LEVEL_DEFAULT;
+	hr = d2dfactory->CreateWicBitmapRenderTarget(l->bitmap, &props, &(l->rt));
+	if (hr != S_OK)
+		logHRESULT(L"error creating uiDrawCachedLayer render target", hr);
+	return l;
+}
+
+void uiDrawFreeLayer(uiDrawCachedLayer *l)
+{
+	if (l->c != NULL)
+		uiprivUserBug("You cannot free a uiDrawCachedLayer that is being drawn into. (layer: %p)", l);
+	l->rt->Release();
+	l->bitmap->Release();
+	uiprivFree(l);
+}
+
+uiDrawContext *uiDrawLayerBegin(uiDrawCachedLayer *l)
+{
+	D2D1_COLOR_F transparent;
+
+	if (l->c != NULL)
+		uiprivUserBug("You cannot call uiDrawLayerBegin() on a uiDrawCachedLayer that is already being drawn into. (layer: %p)", l);
+	l->rt->BeginDraw();
+	ZeroMemory(&transparent, sizeof (D2D1_COLOR_F));
+	l->rt->Clear(&transparent);
+	l->c = newContext(l->rt);
+	return l->c;
+}
+
+void uiDrawLayerEnd(uiDrawCachedLayer *l)
+{
+	HRESULT hr;
+
+	if (l->c == NULL)
+		uiprivUserBug("You cannot call uiDrawLayerEnd() without first calling uiDrawLayerBegin(). (layer: %p)", l);
+	freeContext(l->c);
+	l->c = NULL;
+	hr = l->rt->EndDraw(NULL, NULL);
+	if (hr != S_OK)
+		logHRESULT(L"error drawing uiDrawCachedLayer", hr);
+	l->valid = TRUE;
+}
+
+void uiDrawLayerInvalidate(uiDrawCachedLayer *l)
+{
+	l->valid = FALSE;
+}
+
+int uiDrawLayerValid(uiDrawCachedLayer *l)
+{
+	return l->valid;
+}
+
+IWICBitmap *uiprivLayerBitmap(uiDrawCachedLayer *l, uiDrawContext *c, double *width, double *height)
+{
+	if (l->c == c)
+		uiprivUserBug("You cannot draw a uiDrawCachedLayer into itself. (layer: %p)", l);
+	*width = l->width;
+	*height = l->height;
+	return l->bitmap;
+}
@@ -10,14 +10,13 @@ struct uiDrawPath {
 	ID2D1PathGeometry *path;
 	ID2D1GeometrySink *sink;
 	BOOL inFigure;
+	uiDrawFillMode fillmode;
 };
 
-uiDrawPath *uiDrawNewPath(uiDrawFillMode fillmode)
+static void openPath(uiDrawPath *p, uiDrawFillMode fillmode)
 {
-	uiDrawPath *p;
 	HRESULT hr;
 
-	p = uiprivNew(uiDrawPath);
 	hr = d2dfactory->CreatePathGeometry(&(p->path));
 	if (hr != S_OK)
 		logHRESULT(L"error creating path", hr);
@@ -32,20 +31,44 @@ uiDrawPath *uiDrawNewPath(uiDrawFillMode fillmode)
 		p->sink->SetFillMode(D2D1_FILL_MODE_ALTERNATE);
 		break;
 	}
-	return p;
+	p->fillmode = fillmode;
 }
 
-void uiDrawFreePath(uiDrawPath *p)
+static void closePath(uiDrawPath *p)
 {
 	if (p->inFigure)
 		p->sink->EndFigure(D2D1_FIGURE_END_OPEN);
+	p->inFigure = FALSE;
 	if (p->sink != NULL)
 		// TODO close sink first?
 		p->sink->Release();
+	p->sink = NULL;
 	p->path->Release();
+	p->path = NULL;
+}
+
+uiDrawPath *uiDrawNewPath(uiDrawFillMode fillmode)
+{
+	uiDrawPath *p;
+
+	p = uiprivNew(uiDrawPath);
+	openPath(p, fillmode);
+	return p;
+}
+
+void uiDrawFreePath(uiDrawPath *p)
+{
+	closePath(p);
 	uiprivFree(p);
 }
 
+// Direct2D path geometries can't be reopened once they're closed, so we have to start over
+void uiDrawPathReset(uiDrawPath *p)
+{
+	closePath(p);
+	openPath(p, p->fillmode);
+}
+
 void uiDrawPathNewFigure(uiDrawPath *p, double x, double y)
 {
 	D2D1_POINT_2F pt;
@@ -243,6 +266,32 @@ void uiDrawPathAddRectangle(uiDrawPath *p, double x, double y, double width, dou
 	uiDrawPathCloseFigure(p);
 }
 
+void uiDrawPathAddPolyline(uiDrawPath *p, const double *xy, size_t n)
+{
+	D2D1_POINT_2F pts[256];
+	size_t i, npts;
+
+	if (p->sink == NULL)
+		uiprivUserBug("You cannot modify a uiDrawPath that has been ended. (path: %p)", p);
+	if (n == 0)
+		return;
+
+	uiDrawPathNewFigure(p, xy[0], xy[1]);
+	// hand the lines to Direct2D in batches to save on calls into the sink
+	npts = 0;
+	for (i = 1; i < n; i++) {
+		pts[npts].x = xy[2 * i];
+		pts[npts].y = xy[2 * i + 1];
+		npts++;
+		if (npts == 256) {
+			p->sink->AddLines(pts, npts);
+			npts = 0;
+		}
+	}
+	if (npts != 0)
+		p->sink->AddLines(pts, npts);
+}
+
 void uiDrawPathEnd(uiDrawPath *p)
 {
 	HRESULT hr;
@@ -271,3 +320,21 @@ ID2D1PathGeometry *pathGeometry(uiDrawPath *p)
 		uiprivUserBug("You cannot draw with a uiDrawPath that was not ended. (path: %p)", p);
 	return p->path;
 }
+
+int uiDrawPathBounds(uiDrawPath *p, double *x, double *y, double *width, double *height)
+{
+	D2D1_RECT_F r;
+	HRESULT hr;
+
+	hr = pathGeometry(p)->GetBounds(NULL, &r);
+	if (hr != S_OK)
+		logHRESULT(L"error getting path bounds", hr);
+	// empty geometries have left > right
+	if (r.left > r.right || r.top > r.bottom)
+		return 0;
+	*x = r.left;
+	*y = r.top;
+	*width = r.right - r.left;
+	*height = r.bottom - r.top;
+	return 1;
+}
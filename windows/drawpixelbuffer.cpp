@@ -0,0 +1,121 @@
+// 18 october 2026
+#include "uipriv_windows.hpp"
+#include "draw.hpp"
+
+// Direct2D can't draw from our memory directly, so the pixels live here and are copied into a bitmap that belongs to whichever render target last drew them
+// only the parts that changed since then are copied again, unless the render target changed too
+struct uiDrawPixelBuffer {
+	int width;
+	int height;
+	uint8_t *pixels;
+	BOOL writing;
+	ID2D1Bitmap *bitmap;
+	// we hold a reference to this so a new render target can't show up at the same address and fool us
+	ID2D1RenderTarget *bitmapRT;
+	BOOL dirty;
+	D2D1_RECT_U dirtyRect;
+};
+
+uiDrawPixelBuffer *uiDrawNewPixelBuffer(int width, int height)
+{
+	uiDrawPixelBuffer *pb;
+
+	if (width <= 0 || height <= 0)
+		uiprivUserBug("You cannot create a uiDrawPixelBuffer of size %dx%d.", width, height);
+	pb = uiprivNew(uiDrawPixelBuffer);
+	pb->width = width;
+	pb->height = height;
+	// uiprivAlloc() zeroes this for us, so it starts out transparent
+	pb->pixels = (uint8_t *) uiprivAlloc(width * height * 4, "uint8_t[]");
+	return pb;
+}
+
+static void freeBitmap(uiDrawPixelBuffer *pb)
+{
+	if (pb->bitmap != NULL) {
+		pb->bitmap->Release();
+		pb->bitmapRT->Release();
+	}
+	pb->bitmap = NULL;
+	pb->bitmapRT = NULL;
+}
+
+void uiDrawFreePixelBuffer(uiDrawPixelBuffer *pb)
+{
+	freeBitmap(pb);
+	uiprivFree(pb->pixels);
+	uiprivFree(pb);
+}
+
+uint8_t *uiDrawPixelBufferBegin(uiDrawPixelBuffer *pb, int *stride)
+{
+	if (pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferBegin() on a uiDrawPixelBuffer that is already being written to. (pixel buffer: %p)", pb);
+	pb->writing = TRUE;
+	*stride = pb->width * 4;
+	return pb->pixels;
+}
+
+void uiDrawPixelBufferEnd(uiDrawPixelBuffer *pb, int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight)
+{
+	UINT32 left, top, right, bottom;
+
+	if (!pb->writing)
+		uiprivUserBug("You cannot call uiDrawPixelBufferEnd() without first calling uiDrawPixelBufferBegin(). (pixel buffer: %p)", pb);
+	pb->writing = FALSE;
+	left = (UINT32) max(dirtyX, 0);
+	top = (UINT32) max(dirtyY, 0);
+	right = (UINT32) min(dirtyX + dirtyWidth, pb->width);
+	bottom = (UINT32) min(dirtyY + dirtyHeight, pb->height);
+	if (left >= right || top >= bottom)
+		return;
+	if (!pb->dirty) {
+		pb->dirtyRect.left = left;
+		pb->dirtyRect.top = top;
+		pb->dirtyRect.right = right;
+		pb->dirtyRect.bottom = bottom;
+		pb->dirty = TRUE;
+		return;
+	}
+	pb->dirtyRect.left = min(pb->dirtyRect.left, left);
+	pb->dirtyRect.top = min(pb->dirtyRect.top, top);
+	pb->dirtyRect.right = max(pb->dirtyRect.right, right);
+	pb->dirtyRect.bottom = max(pb->dirtyRect.bottom, bottom);
+}
+
+ID2D1Bitmap *uiprivPixelBufferBitmap(uiDrawPixelBuffer *pb, uiDrawContext *c)
+{
+	D2D1_SIZE_U size;
+	D2D1_BITMAP_PROPERTIES props;
+	HRESULT hr;
+
+	if (pb->writing)
+		uiprivUserBug("You cannot draw a uiDrawPixelBuffer that is being written to. (pixel buffer: %p)", pb);
+	if (pb->bitmapRT != c->rt) {
+		freeBitmap(pb);
+		size.width = pb->width;
+		size.height = pb->height;
+		ZeroMemory(&props, sizeof (D2D1_BITMAP_PROPERTIES));
+		props.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+		props.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+		// 96 DPI makes one pixel one DIP, which uiDrawPixels() then stretches however it's told to
+		props.dpiX = 96;
+		props.dpiY = 96;
+		hr = c->rt->CreateBitmap(size, pb->pixels, pb->width * 4, &props, &(pb->bitmap));
+		if (hr != S_OK)
+			logHRESULT(L"error creating bitmap for uiDrawPixelBuffer", hr);
+		pb->bitmapRT = c->rt;
+		pb->bitmapRT->AddRef();
+		pb->dirty = FALSE;
+		return pb->bitmap;
+	}
+	if (pb->dirty) {
+		hr = pb->bitmap->CopyFromMemory(&(pb->dirtyRect),
+			pb->pixels + pb->dirtyRect.top * pb->width * 4 + pb->dirtyRect.left * 4,
+			pb->width * 4);
+		if (hr != S_OK)
+			logHRESULT(L"error updating bitmap for uiDrawPixelBuffer", hr);
+		pb->dirty = FALSE;
+	}
+	return pb->bitmap;
+}
@@ -93,6 +93,12 @@ uiDrawTextLayout *uiDrawNewTextLayout(uiDrawTextLayoutParams *p)
 	return tl;
 }
 
+// TODO do the layout on a background thread
+void uiDrawNewTextLayoutAsync(uiDrawTextLayoutParams *p, void (*f)(uiDrawTextLayout *tl, void *data), void *data)
+{
+	uiprivFallbackNewTextLayoutAsync(p, f, data);
+}
+
 void uiDrawFreeTextLayout(uiDrawTextLayout *tl)
 {
 	uiprivFree(tl->u16tou8);
@@ -536,6 +542,91 @@ void uiDrawTextLayoutExtents(uiDrawTextLayout *tl, double *width, double *height
 	*height = metrics.height;
 }
 
+// TODO reuse a single IDWriteTextFormat for the whole batch
+void uiDrawMeasureTexts(const uiFontDescriptor *desc, const char **strings, size_t n, double *widths, double *heights)
+{
+	uiprivFallbackMeasureTexts(desc, strings, n, widths, heights);
+}
+
+// DirectWrite only provides font metrics in design units and only for fonts that exist, so just ask a one-line layout instead; this also gets font fallback right
+void uiFontMetrics(const uiFontDescriptor *desc, double *ascent, double *descent, double *lineHeight, double *avgCharWidth)
+{
+	IDWriteTextFormat *format;
+	IDWriteTextLayout *layout;
+	DWRITE_LINE_METRICS lm;
+	UINT32 n;
+	WCHAR *wfamily;
+	HRESULT hr;
+
+	wfamily = toUTF16(desc->Family);
+	hr = dwfactory->CreateTextFormat(
+		wfamily, NULL,
+		uiprivWeightToDWriteWeight(desc->Weight),
+		uiprivItalicToDWriteStyle(desc->Italic),
+		uiprivStretchToDWriteStretch(desc->Stretch),
+		pointSizeToDWriteSize(desc->Size),
+		L"",
+		&format);
+	uiprivFree(wfamily);
+	if (hr != S_OK)
+		logHRESULT(L"error creating IDWriteTextFormat", hr);
+	hr = dwfactory->CreateTextLayout(L"x", 1,
+		format,
+		FLT_MAX, FLT_MAX,
+		&layout);
+	if (hr != S_OK)
+		logHRESULT(L"error creating IDWriteTextLayout", hr);
+	hr = layout->GetLineMetrics(&lm, 1, &n);
+	if (hr != S_OK)
+		logHRESULT(L"error getting IDWriteTextLayout line metrics", hr);
+	layout->Release();
+	format->Release();
+
+	if (ascent != NULL)
+		*ascent = lm.baseline;
+	if (descent != NULL)
+		*descent = lm.height - lm.baseline;
+	if (lineHeight != NULL)
+		*lineHeight = lm.height;
+	if (avgCharWidth != NULL)
+		*avgCharWidth = uiprivFallbackAverageCharWidth(desc);
+}
+
+// DirectWrite keeps the system font collection loaded for us, so there's nothing to cache here
+void uiListFontFamilies(uiListFontFamiliesFunc f, void *data)
+{
+	fontCollection *fc;
+	IDWriteFontFamily *family;
+	WCHAR *wname;
+	char *name;
+	UINT32 i, n;
+	uiForEach ret;
+	HRESULT hr;
+
+	fc = uiprivLoadFontCollection();
+	n = fc->fonts->GetFontFamilyCount();
+	for (i = 0; i < n; i++) {
+		hr = fc->fonts->GetFontFamily(i, &family);
+		if (hr != S_OK)
+			logHRESULT(L"error getting font family", hr);
+		wname = uiprivFontCollectionFamilyName(fc, family);
+		family->Release();
+		name = toUTF8(wname);
+		uiprivFree(wname);
+		ret = (*f)(name, data);
+		uiprivFree(name);
+		if (ret == uiForEachStop)
+			break;
+	}
+	uiprivFontCollectionFree(fc);
+}
+
+// uiInitFlagWarmUpFonts does nothing here yet
+int uiFontWarmUpStats(double *seconds)
+{
+	return 0;
+}
+
 void uiLoadControlFont(uiFontDescriptor *f)
 {
 	fontCollection *collection;
@@ -1,4 +1,5 @@
 #include "uipriv_windows.hpp"
+#include "draw.hpp"
 
 // TODO:
 // - is the alpha channel ignored when drawing images in tables?
@@ -17,12 +18,35 @@ void uiprivUninitImage(void)
 	uiprivWICFactory = NULL;
 }
 
+// uiDrawImage() keeps the last few resized copies of each image around, most recently used first
+#define maxScaledBitmaps 4
+
+struct scaledBitmap {
+	IWICBitmap *src;
+	int width;
+	int height;
+	uiDrawImageFilter filter;
+	ID2D1Bitmap *bitmap;
+	// as with uiDrawPixelBuffer, we hold a reference to this so a new render target can't show up at the same address and fool us
+	ID2D1RenderTarget *rt;
+};
+
 struct uiImage {
 	double width;
 	double height;
 	std::vector<IWICBitmap *> *bitmaps;
+	std::vector<struct scaledBitmap> *scaled;
 };
 
+static void freeScaledBitmaps(uiImage *i)
+{
+	for (struct scaledBitmap &sb : *(i->scaled)) {
+		sb.bitmap->Release();
+		sb.rt->Release();
+	}
+	i->scaled->clear();
+}
+
 uiImage *uiNewImage(double width, double height)
 {
 	uiImage *i;
@@ -31,11 +55,14 @@ uiImage *uiNewImage(double width, double height)
 	i->width = width;
 	i->height = height;
 	i->bitmaps = new std::vector<IWICBitmap *>;
+	i->scaled = new std::vector<struct scaledBitmap>;
 	return i;
 }
 
 void uiFreeImage(uiImage *i)
 {
+	freeScaledBitmaps(i);
+	delete i->scaled;
 	for (IWICBitmap *b : *(i->bitmaps))
 		b->Release();
 	delete i->bitmaps;
@@ -106,6 +133,8 @@ void uiImageAppend(uiImage *i, void *pixels, int pixelWidth, int pixelHeight, in
 
 	l->Release();
 	i->bitmaps->push_back(b);
+	// a new representation may be a better match than the one a resized copy was made from
+	freeScaledBitmaps(i);
 }
 
 struct matcher {
@@ -160,22 +189,130 @@ writeMatch:
 	m->distY = abs(m->targetY - y);
 }
 
-IWICBitmap *uiprivImageAppropriateForDC(uiImage *i, HDC dc)
+static IWICBitmap *appropriateBitmap(uiImage *i, int targetX, int targetY)
 {
 	struct matcher m;
 
 	m.best = NULL;
 	m.distX = INT_MAX;
 	m.distY = INT_MAX;
-	// TODO explain this
-	m.targetX = MulDiv(i->width, GetDeviceCaps(dc, LOGPIXELSX), 96);
-	m.targetY = MulDiv(i->height, GetDeviceCaps(dc, LOGPIXELSY), 96);
+	m.targetX = targetX;
+	m.targetY = targetY;
 	m.foundLarger = false;
 	for (IWICBitmap *b : *(i->bitmaps))
 		match(b, &m);
 	return m.best;
 }
 
+IWICBitmap *uiprivImageAppropriateForDC(uiImage *i, HDC dc)
+{
+	// TODO explain this
+	return appropriateBitmap(i,
+		MulDiv(i->width, GetDeviceCaps(dc, LOGPIXELSX), 96),
+		MulDiv(i->height, GetDeviceCaps(dc, LOGPIXELSY), 96));
+}
+
+// indexed by uiDrawImageFilter
+static const WICBitmapInterpolationMode scalerModes[] = {
+	WICBitmapInterpolationModeNearestNeighbor,
+	WICBitmapInterpolationModeLinear,
+	// this is the one WIC recommends for downscaling
+	WICBitmapInterpolationModeFant,
+};
+
+static ID2D1Bitmap *newScaledBitmap(uiDrawContext *c, IWICBitmap *b, int width, int height, uiDrawImageFilter filter)
+{
+	UINT ux, uy;
+	IWICBitmapScaler *scaler;
+	WICPixelFormatGUID guid;
+	IWICFormatConverter *conv;
+	IWICBitmapSource *src;
+	D2D1_BITMAP_PROPERTIES props;
+	ID2D1Bitmap *bitmap;
+	HRESULT hr;
+
+	hr = b->GetSize(&ux, &uy);
+	if (hr != S_OK)
+		logHRESULT(L"error calling GetSize() in uiDrawImage()", hr);
+	// special case: don't invoke a scaler if the size is the same
+	if (width == (int) ux && height == (int) uy) {
+		b->AddRef();		// for the Release() later
+		src = b;
+	} else {
+		hr = uiprivWICFactory->CreateBitmapScaler(&scaler);
+		if (hr != S_OK)
+			logHRESULT(L"error creating WIC bitmap scaler for uiDrawImage()", hr);
+		hr = scaler->Initialize(b, width, height, scalerModes[filter]);
+		if (hr != S_OK)
+			logHRESULT(L"error initializing WIC bitmap scaler for uiDrawImage()", hr);
+		// see uiprivWICToGDI() for why this is needed
+		hr = scaler->GetPixelFormat(&guid);
+		if (hr != S_OK)
+			logHRESULT(L"error getting WIC bitmap scaler pixel format for uiDrawImage()", hr);
+		if (IsEqualGUID(guid, formatForGDI))
+			src = scaler;
+		else {
+			hr = uiprivWICFactory->CreateFormatConverter(&conv);
+			if (hr != S_OK)
+				logHRESULT(L"error creating WIC format converter for uiDrawImage()", hr);
+			hr = conv->Initialize(scaler, formatForGDI,
+				WICBitmapDitherTypeNone, NULL, 0, WICBitmapPaletteTypeMedianCut);
+			if (hr != S_OK)
+				logHRESULT(L"error initializing WIC format converter for uiDrawImage()", hr);
+			scaler->Release();
+			src = conv;
+		}
+	}
+
+	ZeroMemory(&props, sizeof (D2D1_BITMAP_PROPERTIES));
+	props.pixelFormat.format = DXGI_FORMAT_B8G8R8A8_UNORM;
+	props.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+	// 96 DPI makes one pixel one DIP, which uiDrawImage() then stretches to fit
+	props.dpiX = 96;
+	props.dpiY = 96;
+	// this copies the pixels, so the scaler only runs once
+	hr = c->rt->CreateBitmapFromWicBitmap(src, &props, &bitmap);
+	if (hr != S_OK)
+		logHRESULT(L"error creating bitmap for uiDrawImage()", hr);
+	src->Release();
+	return bitmap;
+}
+
+ID2D1Bitmap *uiprivImageBitmap(uiImage *i, uiDrawContext *c, int width, int height, uiDrawImageFilter filter)
+{
+	IWICBitmap *b;
+	struct scaledBitmap sb;
+	size_t n;
+
+	if (i->bitmaps->size() == 0)
+		uiprivUserBug("You cannot draw a uiImage that has no representations. (image: %p)", i);
+	b = appropriateBitmap(i, width, height);
+	for (n = 0; n < i->scaled->size(); n++) {
+		sb = (*(i->scaled))[n];
+		if (sb.src == b && sb.width == width && sb.height == height && sb.filter == filter && sb.rt == c->rt) {
+			// move it to the front so it's the last to go
+			i->scaled->erase(i->scaled->begin() + n);
+			i->scaled->insert(i->scaled->begin(), sb);
+			return sb.bitmap;
+		}
+	}
+
+	sb.src = b;
+	sb.width = width;
+	sb.height = height;
+	sb.filter = filter;
+	sb.bitmap = newScaledBitmap(c, b, width, height, filter);
+	sb.rt = c->rt;
+	sb.rt->AddRef();
+	if (i->scaled->size() == maxScaledBitmaps) {
+		i->scaled->back().bitmap->Release();
+		i->scaled->back().rt->Release();
+		i->scaled->pop_back();
+	}
+	i->scaled->insert(i->scaled->begin(), sb);
+	return sb.bitmap;
+}
+
 // TODO this needs to center images if the given size is not the same aspect ratio
 HRESULT uiprivWICToGDI(IWICBitmap *b, HDC dc, int width, int height, HBITMAP *hb)
 {
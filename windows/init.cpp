@@ -62,7 +62,7 @@ const char *uiInit(uiInitOptions *o)
 	INITCOMMONCONTROLSEX icc;
 	HRESULT hr;
 
-	uiprivOptions = *o;
+	uiprivLoadInitOptions(o);
 
 	initAlloc();
 
@@ -140,12 +140,14 @@ const char *uiInit(uiInitOptions *o)
 
 void uiUninit(void)
 {
+	uiprivUninitAreaAnimation();
 	uiprivUninitTimers();
 	uiprivUninitImage();
 	uninitMenus();
 	unregisterD2DScratchClass();
 	unregisterMessageFilter();
 	unregisterArea();
+	uiprivUninitFallbackTextLayouts();
 	uiprivUninitDrawText();
 	uninitDraw();
 	CoUninitialize();
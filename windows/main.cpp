@@ -158,3 +158,13 @@ void uiprivUninitTimers(void)
 		uiprivFree(t->first);
 	timers.clear();
 }
+
+double uiprivMonotonicTime(void)
+{
+	LARGE_INTEGER count, frequency;
+
+	// these can't fail on Windows XP and newer
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return ((double) (count.QuadPart)) / ((double) (frequency.QuadPart));
+}